@@ -0,0 +1,131 @@
+//
+// Copyright (c) 2008-2020 Sean Farrell
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of
+// this software and associated documentation files (the "Software"), to deal in
+// the Software without restriction, including without limitation the rights to use,
+// copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the
+// Software, and to permit persons to whom the Software is furnished to do so,
+// subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+// INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+// PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+// HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+// OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+// SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+
+#include <string>
+#include <vector>
+#include <cstdio>
+#include <stdexcept>
+#include <gtest/gtest.h>
+
+#include <libxmlmm/BatchLoader.h>
+#include <libxmlmm/exceptions.h>
+
+static std::vector<std::string> make_messages(size_t count)
+{
+    std::vector<std::string> messages;
+    for (size_t i = 0; i < count; i++)
+    {
+        messages.push_back("<message id='" + std::to_string(i) + "'><body>Message " + std::to_string(i) + "</body></message>");
+    }
+    return messages;
+}
+
+TEST(BatchLoaderTest, load_buffers)
+{
+    const std::vector<std::string> messages = make_messages(100);
+    std::vector<std::string_view> buffers(messages.begin(), messages.end());
+    buffers[42] = "<message><body>broken</message>";
+
+    xml::BatchLoader loader(4);
+    EXPECT_EQ(4, loader.get_thread_count());
+
+    std::vector<xml::BatchLoader::Result> results = loader.load_buffers(buffers);
+    ASSERT_EQ(100, results.size());
+
+    std::vector<bool> seen(100, false);
+    for (size_t i = 0; i < results.size(); i++)
+    {
+        const size_t index = results[i].index;
+        ASSERT_LT(index, 100);
+        EXPECT_FALSE(seen[index]);
+        seen[index] = true;
+
+        if (index == 42)
+        {
+            EXPECT_TRUE(results[i].document == NULL);
+            EXPECT_FALSE(results[i].error.empty());
+        }
+        else
+        {
+            ASSERT_TRUE(results[i].document != NULL);
+            EXPECT_TRUE(results[i].error.empty());
+            EXPECT_EQ(std::to_string(index), results[i].document->query_string("/message/@id"));
+        }
+    }
+}
+
+TEST(BatchLoaderTest, load_files)
+{
+    const std::vector<std::string> messages = make_messages(10);
+    std::vector<std::string> files;
+    for (size_t i = 0; i < messages.size(); i++)
+    {
+        files.push_back("BatchLoaderTest_load_files_" + std::to_string(i) + ".xml");
+        xml::Document doc(messages[i]);
+        doc.write_to_file(files.back());
+    }
+    files.push_back("does-not-exist.xml");
+
+    size_t loaded = 0;
+    size_t failed = 0;
+    xml::BatchLoader loader(3);
+    loader.load_files(files, [&] (xml::BatchLoader::Result& result) {
+        if (result.document)
+        {
+            EXPECT_EQ("Message " + std::to_string(result.index), result.document->query_string("/message/body"));
+            loaded++;
+        }
+        else
+        {
+            EXPECT_EQ(10, result.index);
+            failed++;
+        }
+    });
+
+    for (size_t i = 0; i < messages.size(); i++)
+    {
+        std::remove(files[i].c_str());
+    }
+
+    EXPECT_EQ(10, loaded);
+    EXPECT_EQ(1, failed);
+}
+
+TEST(BatchLoaderTest, empty_batch)
+{
+    xml::BatchLoader loader;
+    EXPECT_LE(1, loader.get_thread_count());
+    EXPECT_EQ(0, loader.load_buffers(std::vector<std::string_view>()).size());
+}
+
+TEST(BatchLoaderTest, callback_exception_stops_batch)
+{
+    const std::vector<std::string> messages = make_messages(200);
+    const std::vector<std::string_view> buffers(messages.begin(), messages.end());
+
+    size_t calls = 0;
+    xml::BatchLoader loader(2);
+    EXPECT_THROW(loader.load_buffers(buffers, [&calls] (xml::BatchLoader::Result&) {
+        calls++;
+        throw std::runtime_error("stop");
+    }), std::runtime_error);
+    EXPECT_EQ(1, calls);
+}
@@ -21,7 +21,9 @@
 
 #include <string>
 #include <stdexcept>
+#include <cstdio>
 #include <gtest/gtest.h>
+#include <libxml/parser.h>
 
 #include <libxmlmm/Document.h>
 #include <libxmlmm/exceptions.h>
@@ -161,7 +163,7 @@ TEST(DocumentTest, xpath_string_query)
     std::string body_text = doc.query_string("/message/body/text()");
     EXPECT_EQ("Hello everybody!", body_text);
     double to_count = doc.query_number("count(/message/to)");
-    EXPECT_FLOAT_EQ(3.0, to_count, 1e-4);
+    EXPECT_NEAR(3.0, to_count, 1e-4);
 
     std::string message_version_string = doc.query_string("/message/@version");
     EXPECT_EQ("1.2", message_version_string);
@@ -248,3 +250,139 @@ TEST(DocumentTest, writes_latin1_to_file)
         "<test/>\n";
     EXPECT_EQ(ref, buff.str());
 }
+
+TEST(DocumentTest, read_from_file_mapped)
+{
+    const std::string file = "DocumentTest_read_from_file_mapped.xml";
+
+    xml::Document ref;
+    xml::Element* root = ref.create_root_element("test");
+    root->add_element("child")->set_text("Hello mapped world!");
+    ref.write_to_file(file);
+
+    xml::Document check;
+    check.read_from_file(file);
+
+    xml::Document doc;
+    doc.read_from_file_mapped(file);
+    std::remove(file.c_str());
+
+    EXPECT_EQ("Hello mapped world!", doc.query_string("/test/child"));
+    EXPECT_EQ(check.write_to_string(), doc.write_to_string());
+}
+
+TEST(DocumentTest, read_from_file_mapped_throws_on_missing_file)
+{
+    xml::Document doc;
+    EXPECT_THROW(doc.read_from_file_mapped("does-not-exist.xml"), xml::Exception);
+}
+
+TEST(DocumentTest, read_from_buffer)
+{
+    // Only the first size bytes are xml, the rest must not be looked at.
+    const char buffer[] = "<test><child>Hello</child></test>garbage";
+    const size_t size = sizeof("<test><child>Hello</child></test>") - 1;
+
+    xml::Document doc;
+    doc.read_from_buffer(buffer, size);
+    EXPECT_EQ("Hello", doc.query_string("/test/child"));
+
+    doc.read_from_buffer(std::string_view(buffer, size));
+    EXPECT_EQ("Hello", doc.query_string("/test/child"));
+}
+
+TEST(DocumentTest, read_from_stream_spanning_blocks)
+{
+    std::stringstream xml;
+    xml << "<?xml version='1.0'?>\n<list>\n";
+    for (int i = 0; i < 20000; i++)
+    {
+        xml << "    <item id='" << i << "'>Item number " << i << "</item>\n";
+    }
+    xml << "</list>\n";
+
+    xml::Document doc;
+    doc.read_from_stream(xml);
+
+    EXPECT_FLOAT_EQ(20000.0, doc.query_number("count(/list/item)"));
+    EXPECT_EQ("Item number 19999", doc.query_string("/list/item[@id='19999']"));
+}
+
+TEST(DocumentTest, read_from_stream_throws_on_invalid_xml)
+{
+    std::stringstream xml("<?xml version='1.0'?>\n<test><unclosed></test>\n");
+
+    xml::Document doc;
+    EXPECT_THROW(doc.read_from_stream(xml), xml::Exception);
+}
+
+TEST(DocumentTest, read_with_no_blanks)
+{
+    const std::string xml =
+        "<?xml version='1.0'?>\n"
+        "<list>\n"
+        "    <item>One</item>\n"
+        "    <item>Two</item>\n"
+        "</list>\n";
+
+    xml::Document doc;
+    doc.read_from_string(xml);
+    EXPECT_EQ(5, doc.get_root_element()->get_children().size());
+
+    xml::ParseOptions options;
+    options.no_blanks = true;
+    doc.read_from_string(xml, options);
+    EXPECT_EQ(2, doc.get_root_element()->get_children().size());
+}
+
+TEST(DocumentTest, parse_options_flags)
+{
+    xml::ParseOptions options;
+    EXPECT_EQ(0, options.get_flags());
+
+    options.huge = true;
+    options.no_network = true;
+    options.extra_flags = XML_PARSE_NOXINCNODE;
+    EXPECT_EQ(XML_PARSE_HUGE | XML_PARSE_NONET | XML_PARSE_NOXINCNODE, options.get_flags());
+}
+
+TEST(DocumentTest, lazy_wrapping)
+{
+    xml::set_lazy_wrapping(true);
+    EXPECT_TRUE(xml::get_lazy_wrapping());
+
+    xml::Document doc;
+    doc.read_from_string("<message><to>Joe</to><to>Sally</to><body>Hello!</body></message>");
+
+    xml::Element* root = doc.get_root_element();
+    EXPECT_EQ(root, doc.get_root_element());
+    EXPECT_EQ("message", root->get_name());
+
+    std::vector<xml::Element*> to = doc.find_elements("/message/to");
+    ASSERT_EQ(2, to.size());
+    EXPECT_EQ("Sally", to[1]->get_text());
+    EXPECT_EQ(root, to[1]->get_parent());
+    EXPECT_EQ(to[0], root->get_children()[0]);
+    EXPECT_EQ("Hello!", doc.query_string("/message/body"));
+
+    xml::set_lazy_wrapping(false);
+}
+
+TEST(DocumentTest, query_number_with_whitespace)
+{
+    xml::Document doc;
+    doc.read_from_string("<a>\n  <v>\n    1.5\n  </v>\n  <w>2 </w>\n</a>\n");
+
+    EXPECT_DOUBLE_EQ(1.5, doc.query_number("/a/v"));
+    EXPECT_DOUBLE_EQ(2.0, doc.query_number("/a/w"));
+}
+
+TEST(DocumentTest, query_number_reads_leading_number)
+{
+    xml::Document doc;
+    doc.read_from_string("<a><w>12px</w><n>3 apples</n><x>apples</x></a>");
+
+    EXPECT_DOUBLE_EQ(12.0, doc.query_number("/a/w"));
+    EXPECT_DOUBLE_EQ(3.0, doc.query_number("/a/n"));
+    EXPECT_DOUBLE_EQ(0.0, doc.query_number("/a/x"));
+}
@@ -20,12 +20,18 @@
 //
 
 #include <string>
+#include <vector>
+#include <iterator>
+#include <cstring>
+#include <cstdlib>
 #include <stdexcept>
 #include <gtest/gtest.h>
+#include <libxml/xmlmemory.h>
 
 #include <libxmlmm/Document.h>
 #include <libxmlmm/Element.h>
 #include <libxmlmm/Comment.h>
+#include <libxmlmm/Attribute.h>
 #include <libxmlmm/exceptions.h>
 
 // NOTE: Elements can not live w/o their Document.
@@ -113,6 +119,70 @@ TEST(ElementTest, rowse_children)
     EXPECT_EQ(element3, children[2]);
 }
 
+TEST(ElementTest, children_range)
+{
+    xml::Document doc;
+    doc.read_from_string("<test>a<row id='1'/><!--c--><cell/><row id='2'/>b</test>");
+    xml::Element* root = doc.get_root_element();
+
+    std::vector<xml::Node*> children = root->get_children();
+    std::vector<xml::Node*> visited;
+    for (xml::Node* child : root->children())
+    {
+        visited.push_back(child);
+    }
+    EXPECT_EQ(children, visited);
+
+    const xml::Element* croot = root;
+    EXPECT_EQ(6, std::distance(croot->children().begin(), croot->children().end()));
+    EXPECT_TRUE(croot->find_element("cell")->children().empty());
+}
+
+TEST(ElementTest, child_elements_range)
+{
+    xml::Document doc;
+    doc.read_from_string("<test>a<row id='1'/><!--c--><cell/><row id='2'/>b</test>");
+    const xml::Element* root = doc.get_root_element();
+
+    std::vector<std::string> names;
+    for (const xml::Element* child : root->child_elements())
+    {
+        names.push_back(child->get_name());
+    }
+    EXPECT_EQ((std::vector<std::string>{"row", "cell", "row"}), names);
+
+    std::vector<std::string> ids;
+    for (const xml::Element* row : root->child_elements("row"))
+    {
+        ids.push_back(row->get_attribute("id"));
+    }
+    EXPECT_EQ((std::vector<std::string>{"1", "2"}), ids);
+
+    const std::string cell = "cell";
+    EXPECT_EQ(1, std::distance(root->child_elements(cell).begin(), root->child_elements(cell).end()));
+    EXPECT_TRUE(root->child_elements("missing").empty());
+    EXPECT_EQ(root->find_element("row"), *root->child_elements(std::string_view("rows", 3)).begin());
+}
+
+TEST(ElementTest, attributes_range)
+{
+    xml::Document doc;
+    doc.read_from_string("<test a='1' b='two' c=''/>");
+    const xml::Element* root = doc.get_root_element();
+
+    std::vector<std::string> pairs;
+    for (const xml::AttributeRange::Entry& attribute : root->attributes())
+    {
+        pairs.push_back(std::string(attribute.get_name()) + "=" + attribute.get_value());
+        EXPECT_EQ(attribute.get_value(), attribute.get_value_view());
+    }
+    EXPECT_EQ((std::vector<std::string>{"a=1", "b=two", "c="}), pairs);
+    EXPECT_EQ("a", root->attributes().begin()->get_name());
+
+    xml::Document empty;
+    EXPECT_TRUE(empty.create_root_element("test")->attributes().empty());
+}
+
 TEST(ElementTest, simple_xpath_querry)
 {
     std::stringstream xmat(
@@ -176,3 +246,213 @@ TEST(ElementTest, set_attribute_with_type)
     EXPECT_TRUE(root->has_attribute("key"));
     EXPECT_EQ("8", root->get_attribute("key"));
 }
+
+TEST(ElementTest, get_attribute_view)
+{
+    xml::Document doc;
+    doc.read_from_string("<test key='value' empty=''/>");
+    const xml::Element* root = doc.get_root_element();
+
+    EXPECT_EQ("value", root->get_attribute_view("key"));
+    EXPECT_EQ("", root->get_attribute_view("empty"));
+    EXPECT_EQ(root->get_attribute_view("key").data(), root->get_attribute_view("key").data());
+    EXPECT_THROW(root->get_attribute_view("missing"), xml::NoSuchAttribute);
+}
+
+TEST(ElementTest, get_attribute_with_entity)
+{
+    xml::Document doc;
+    doc.read_from_string(
+        "<!DOCTYPE test [<!ENTITY name 'World'><!ATTLIST test kind CDATA 'default'>]>"
+        "<test greeting='Hello &name;!'/>");
+    const xml::Element* root = doc.get_root_element();
+
+    EXPECT_EQ("Hello World!", root->get_attribute("greeting"));
+    EXPECT_EQ("Hello World!", root->find_node("@greeting")->get_value());
+    EXPECT_THROW(root->get_attribute_view("greeting"), xml::Exception);
+
+    EXPECT_TRUE(root->has_attribute("kind"));
+    EXPECT_EQ("default", root->get_attribute("kind"));
+    EXPECT_EQ("default", root->get_attribute_view("kind"));
+}
+
+// Counts the blocks libxml allocates and frees.
+static long live_blocks = 0;
+
+static void* counting_malloc(size_t size)
+{
+    live_blocks++;
+    return malloc(size);
+}
+
+static void* counting_realloc(void* ptr, size_t size)
+{
+    if (ptr == NULL)
+    {
+        live_blocks++;
+    }
+    return realloc(ptr, size);
+}
+
+static void counting_free(void* ptr)
+{
+    if (ptr != NULL)
+    {
+        live_blocks--;
+    }
+    free(ptr);
+}
+
+static char* counting_strdup(const char* str)
+{
+    live_blocks++;
+    return strdup(str);
+}
+
+TEST(ElementTest, attribute_access_does_not_leak)
+{
+    xml::Document doc;
+    doc.read_from_string("<test key='value'><item id='1'/></test>");
+    const xml::Element* root = doc.get_root_element();
+    const xml::Node* id = root->find_node("item/@id");
+
+    xmlFreeFunc old_free;
+    xmlMallocFunc old_malloc;
+    xmlReallocFunc old_realloc;
+    xmlStrdupFunc old_strdup;
+    xmlMemGet(&old_free, &old_malloc, &old_realloc, &old_strdup);
+    xmlMemSetup(counting_free, counting_malloc, counting_realloc, counting_strdup);
+
+    live_blocks = 0;
+    for (int i = 0; i < 100000; i++)
+    {
+        root->has_attribute("key");
+        root->has_attribute("missing");
+        root->get_attribute("key");
+        root->get_attribute_view("key");
+        id->get_value();
+        for (const xml::AttributeRange::Entry& attribute : root->attributes())
+        {
+            attribute.get_value_view();
+        }
+    }
+    const long leaked = live_blocks;
+
+    xmlMemSetup(old_free, old_malloc, old_realloc, old_strdup);
+    EXPECT_EQ(0, leaked);
+}
+
+TEST(ElementTest, attribute_numbers_round_trip)
+{
+    xml::Document doc;
+    xml::Element* root = doc.create_root_element("test");
+
+    const double values[] = {0.1, 1.0 / 3.0, 6.02214076e23, -2.5e-300, 1234567.0};
+    for (double value : values)
+    {
+        root->set_attribute("value", value);
+        EXPECT_EQ(value, root->get_attribute<double>("value")) << root->get_attribute("value");
+    }
+
+    root->set_attribute("value", 1234567.0);
+    EXPECT_EQ("1234567", root->get_attribute("value"));
+    root->set_attribute("value", 0.1f);
+    EXPECT_EQ("0.1", root->get_attribute("value"));
+    root->set_attribute("value", -42);
+    EXPECT_EQ(-42, root->get_attribute<int>("value"));
+    root->set_attribute("value", 18446744073709551615ull);
+    EXPECT_EQ(18446744073709551615ull, root->get_attribute<unsigned long long>("value"));
+}
+
+TEST(ElementTest, attribute_number_parsing)
+{
+    xml::Document doc;
+    doc.read_from_string("<test a=' 42' b='+7' c='42 ' d='4x' e='' f='99999999999' g='true' h='0' i='1e3' j='-1'/>");
+    const xml::Element* root = doc.get_root_element();
+
+    EXPECT_EQ(42, root->get_attribute<int>("a"));
+    EXPECT_EQ(7, root->get_attribute<int>("b"));
+    EXPECT_EQ(42, root->get_attribute<int>("c"));
+    EXPECT_THROW(root->get_attribute<int>("d"), xml::Exception);
+    EXPECT_THROW(root->get_attribute<int>("e"), xml::Exception);
+    EXPECT_THROW(root->get_attribute<int>("f"), xml::Exception);
+    EXPECT_THROW(root->get_attribute<unsigned int>("j"), xml::Exception);
+    EXPECT_TRUE(root->get_attribute<bool>("g"));
+    EXPECT_FALSE(root->get_attribute<bool>("h"));
+    EXPECT_DOUBLE_EQ(1000.0, root->get_attribute<double>("i"));
+}
+
+TEST(ElementTest, attribute_number_with_whitespace)
+{
+    xml::Document doc;
+    doc.read_from_string("<test n=' 5 ' m='\t1.5\n' b=' true ' s=' 4 2 '/>");
+    const xml::Element* root = doc.get_root_element();
+
+    EXPECT_EQ(5, root->get_attribute<int>("n"));
+    EXPECT_DOUBLE_EQ(1.5, root->get_attribute<double>("m"));
+    EXPECT_TRUE(root->get_attribute<bool>("b"));
+    EXPECT_THROW(root->get_attribute<int>("s"), xml::Exception);
+}
+
+TEST(ElementTest, string_view_keys)
+{
+    xml::Document doc;
+    xml::Element* root = doc.create_root_element("test");
+
+    // Views into a larger buffer are not null terminated.
+    const std::string buffer = "rowid";
+    const std::string_view row(buffer.data(), 3);
+    const std::string_view id(buffer.data() + 3, 2);
+
+    xml::Element* child = root->add_element(row);
+    EXPECT_EQ("row", child->get_name());
+
+    child->set_attribute(id, row);
+    EXPECT_TRUE(child->has_attribute(id));
+    EXPECT_EQ("row", child->get_attribute(id));
+    EXPECT_EQ("row", child->get_attribute_view(id));
+    EXPECT_EQ(child, root->find_element(row));
+    EXPECT_EQ(1u, root->find_elements(row).size());
+    EXPECT_EQ(child, doc.find_element(std::string_view("/test/row/@id", 9)));
+
+    child->set_attribute(id, 42);
+    EXPECT_EQ(42, child->get_attribute<int>(id));
+
+    child->remove_attribute(id);
+    EXPECT_FALSE(child->has_attribute(id));
+
+    child->set_name(std::string_view("cell", 4));
+    EXPECT_EQ("cell", child->get_name());
+}
+
+TEST(ElementTest, string_view_long_keys)
+{
+    xml::Document doc;
+    xml::Element* root = doc.create_root_element("test");
+
+    // Longer than the stack buffer used to terminate views.
+    const std::string buffer = std::string(200, 'a') + "b";
+    const std::string_view key(buffer.data(), 200);
+
+    root->set_attribute(key, std::string_view("value"));
+    EXPECT_TRUE(root->has_attribute(key));
+    EXPECT_FALSE(root->has_attribute(buffer));
+    EXPECT_EQ("value", root->get_attribute(std::string(200, 'a')));
+}
+
+TEST(ElementTest, literal_keys)
+{
+    xml::Document doc;
+    xml::Element* root = doc.create_root_element("test");
+
+    xml::Element* child = root->add_element("row");
+    child->set_attribute("id", "1");
+    child->set_attribute("n", 2);
+    EXPECT_TRUE(child->has_attribute("id"));
+    EXPECT_EQ("1", child->get_attribute("id"));
+    EXPECT_EQ(2, child->get_attribute<int>("n"));
+    EXPECT_EQ(child, root->find_element("row"));
+    EXPECT_EQ(child, root->find_node("row[@id='1']"));
+    EXPECT_EQ(1u, doc.find_nodes("//row").size());
+    EXPECT_THROW(child->get_attribute("missing"), xml::NoSuchAttribute);
+}
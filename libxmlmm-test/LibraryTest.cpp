@@ -0,0 +1,69 @@
+//
+// Copyright (c) 2008-2020 Sean Farrell
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of
+// this software and associated documentation files (the "Software"), to deal in
+// the Software without restriction, including without limitation the rights to use,
+// copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the
+// Software, and to permit persons to whom the Software is furnished to do so,
+// subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+// INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+// PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+// HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+// OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+// SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+
+#include <gtest/gtest.h>
+
+#include <libxmlmm/Library.h>
+#include <libxmlmm/Document.h>
+
+TEST(LibraryTest, pin)
+{
+    EXPECT_FALSE(xml::Library::is_pinned());
+    {
+        xml::Library library;
+        EXPECT_TRUE(xml::Library::is_pinned());
+
+        for (int i = 0; i < 10; i++)
+        {
+            xml::Document doc("<test>" + std::to_string(i) + "</test>");
+            EXPECT_EQ(std::to_string(i), doc.get_root_element()->get_text());
+        }
+    }
+    EXPECT_FALSE(xml::Library::is_pinned());
+
+    xml::Document doc("<test>after</test>");
+    EXPECT_EQ("after", doc.get_root_element()->get_text());
+}
+
+TEST(LibraryTest, nested)
+{
+    xml::Library outer;
+    {
+        xml::Library inner;
+        EXPECT_TRUE(xml::Library::is_pinned());
+    }
+    EXPECT_TRUE(xml::Library::is_pinned());
+
+    xml::Document doc("<test>nested</test>");
+    EXPECT_EQ("nested", doc.get_root_element()->get_text());
+}
+
+TEST(LibraryTest, documents_from_before)
+{
+    xml::Document before("<test>before</test>");
+    {
+        xml::Library library;
+        xml::Document during("<test>during</test>");
+        EXPECT_EQ("before", before.get_root_element()->get_text());
+        EXPECT_EQ("during", during.get_root_element()->get_text());
+    }
+    EXPECT_EQ("before", before.get_root_element()->get_text());
+}
@@ -0,0 +1,92 @@
+//
+// Copyright (c) 2008-2020 Sean Farrell
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of
+// this software and associated documentation files (the "Software"), to deal in
+// the Software without restriction, including without limitation the rights to use,
+// copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the
+// Software, and to permit persons to whom the Software is furnished to do so,
+// subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+// INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+// PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+// HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+// OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+// SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+
+#include <thread>
+#include <vector>
+#include <gtest/gtest.h>
+
+#include <libxmlmm/NodePool.h>
+
+TEST(NodePoolTest, blocks_freed_by_other_thread_are_returned)
+{
+    const size_t count = 100;
+    std::vector<void*> blocks;
+
+    const xml::NodePool::Statistics before = xml::NodePool::get_statistics();
+
+    std::thread producer([&] () {
+        for (size_t i = 0; i < count; i++)
+        {
+            blocks.push_back(xml::NodePool::allocate(16));
+        }
+    });
+    producer.join();
+
+    EXPECT_EQ(before.used_blocks + count, xml::NodePool::get_statistics().used_blocks);
+
+    // This thread only frees, its cache must go back when it exits.
+    std::thread consumer([&] () {
+        for (void* block : blocks)
+        {
+            xml::NodePool::release(block, 16);
+        }
+    });
+    consumer.join();
+
+    EXPECT_EQ(before.used_blocks, xml::NodePool::get_statistics().used_blocks);
+}
+
+TEST(NodePoolTest, empty_slabs_are_freed)
+{
+    const size_t count = 20 * 1024;
+
+    const xml::NodePool::Statistics before = xml::NodePool::get_statistics();
+
+    size_t peak = 0;
+    std::thread worker([&] () {
+        std::vector<void*> blocks;
+        for (size_t i = 0; i < count; i++)
+        {
+            blocks.push_back(xml::NodePool::allocate(16));
+        }
+        peak = xml::NodePool::get_statistics().slabs;
+        for (void* block : blocks)
+        {
+            xml::NodePool::release(block, 16);
+        }
+    });
+    worker.join();
+
+    const xml::NodePool::Statistics after = xml::NodePool::get_statistics();
+    EXPECT_LE(count / 1024, peak);
+    EXPECT_LE(after.slabs, before.slabs + 2);
+    EXPECT_EQ(before.used_blocks, after.used_blocks);
+}
+
+TEST(NodePoolTest, large_requests_use_the_heap)
+{
+    const xml::NodePool::Statistics before = xml::NodePool::get_statistics();
+
+    void* block = xml::NodePool::allocate(64);
+    ASSERT_TRUE(block != NULL);
+    EXPECT_EQ(before.used_blocks, xml::NodePool::get_statistics().used_blocks);
+    xml::NodePool::release(block, 64);
+}
@@ -0,0 +1,127 @@
+//
+// Copyright (c) 2008-2020 Sean Farrell
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of
+// this software and associated documentation files (the "Software"), to deal in
+// the Software without restriction, including without limitation the rights to use,
+// copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the
+// Software, and to permit persons to whom the Software is furnished to do so,
+// subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+// INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+// PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+// HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+// OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+// SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+
+#include <string>
+#include <gtest/gtest.h>
+
+#include <libxmlmm/Document.h>
+#include <libxmlmm/exceptions.h>
+
+static const std::string catalog =
+    "<catalog>"
+    "<item id='1'>one</item>"
+    "<item id='2'>two</item>"
+    "<item id='3'>three</item>"
+    "<note>four</note>"
+    "</catalog>";
+
+TEST(NodeSetViewTest, iterate_elements)
+{
+    xml::Document doc;
+    doc.read_from_string(catalog);
+
+    xml::NodeSetView<xml::Element> items = doc.select_elements("/catalog/item");
+    ASSERT_EQ(3, items.size());
+    EXPECT_FALSE(items.empty());
+
+    std::string text;
+    for (xml::Element* item : items)
+    {
+        text += item->get_text();
+    }
+    EXPECT_EQ("onetwothree", text);
+    EXPECT_EQ("2", items[1]->get_attribute("id"));
+}
+
+TEST(NodeSetViewTest, same_wrappers_as_find)
+{
+    xml::Document doc;
+    doc.read_from_string(catalog);
+    const xml::Element* root = doc.get_root_element();
+
+    std::vector<const xml::Element*> found = root->find_elements("item");
+    xml::NodeSetView<const xml::Element> selected = root->select_elements("item");
+    ASSERT_EQ(found.size(), selected.size());
+
+    size_t i = 0;
+    for (const xml::Element* item : selected)
+    {
+        EXPECT_EQ(found[i++], item);
+    }
+}
+
+TEST(NodeSetViewTest, early_break)
+{
+    xml::Document doc;
+    doc.read_from_string(catalog);
+
+    const xml::Element* second = NULL;
+    for (const xml::Element* item : doc.select_elements("//item"))
+    {
+        if (item->get_attribute("id") == "2")
+        {
+            second = item;
+            break;
+        }
+    }
+    ASSERT_TRUE(second != NULL);
+    EXPECT_EQ("two", second->get_text());
+}
+
+TEST(NodeSetViewTest, empty_result)
+{
+    xml::Document doc;
+    doc.read_from_string(catalog);
+
+    xml::NodeSetView<xml::Node> nodes = doc.select_nodes("/catalog/missing");
+    EXPECT_EQ(0, nodes.size());
+    EXPECT_TRUE(nodes.empty());
+    EXPECT_TRUE(nodes.begin() == nodes.end());
+}
+
+TEST(NodeSetViewTest, compiled_xpath)
+{
+    xml::Document doc;
+    doc.read_from_string(catalog);
+
+    const xml::XPath ids("/catalog/item/@id");
+    std::string values;
+    for (const xml::Node* id : doc.select_nodes(ids))
+    {
+        values += id->get_value();
+    }
+    EXPECT_EQ("123", values);
+}
+
+TEST(NodeSetViewTest, throws_on_invalid_query)
+{
+    xml::Document doc;
+    doc.read_from_string(catalog);
+
+    EXPECT_THROW(doc.select_nodes("/catalog/[item"), xml::InvalidXPath);
+    EXPECT_THROW(doc.select_nodes("count(/catalog/item)"), xml::Exception);
+}
+
+TEST(NodeSetViewTest, throws_on_empty_document)
+{
+    xml::Document doc;
+    EXPECT_THROW(doc.select_elements("item"), xml::EmptyDocument);
+}
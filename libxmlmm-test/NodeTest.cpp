@@ -0,0 +1,104 @@
+//
+// Copyright (c) 2008-2020 Sean Farrell
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of
+// this software and associated documentation files (the "Software"), to deal in
+// the Software without restriction, including without limitation the rights to use,
+// copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the
+// Software, and to permit persons to whom the Software is furnished to do so,
+// subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+// INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+// PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+// HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+// OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+// SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+
+#include <string>
+#include <vector>
+#include <gtest/gtest.h>
+
+#include <libxmlmm/Document.h>
+#include <libxmlmm/Element.h>
+#include <libxmlmm/Text.h>
+#include <libxmlmm/CData.h>
+#include <libxmlmm/Comment.h>
+#include <libxmlmm/ProcessingInstruction.h>
+#include <libxmlmm/Attribute.h>
+
+static const std::string mixed =
+    "<test a='1'>text<![CDATA[data]]><!--comment--><?pi value?><child/></test>";
+
+TEST(NodeTest, type)
+{
+    xml::Document doc;
+    doc.read_from_string(mixed);
+    const xml::Element* root = doc.get_root_element();
+
+    EXPECT_EQ(XML_ELEMENT_NODE, root->type());
+    EXPECT_EQ(XML_TEXT_NODE, root->find_node("text()")->type());
+    EXPECT_EQ(XML_COMMENT_NODE, root->find_node("comment()")->type());
+    EXPECT_EQ(XML_PI_NODE, root->find_node("processing-instruction()")->type());
+    EXPECT_EQ(XML_ATTRIBUTE_NODE, root->find_node("@a")->type());
+}
+
+TEST(NodeTest, is)
+{
+    xml::Document doc;
+    doc.read_from_string(mixed);
+    const xml::Element* root = doc.get_root_element();
+
+    const xml::Node* text = root->find_node("text()");
+    EXPECT_TRUE(text->is<xml::Node>());
+    EXPECT_TRUE(text->is<xml::Content>());
+    EXPECT_TRUE(text->is<xml::Text>());
+    EXPECT_FALSE(text->is<xml::CData>());
+    EXPECT_FALSE(text->is<xml::Element>());
+
+    std::vector<const xml::Node*> children = root->get_children();
+    ASSERT_EQ(5u, children.size());
+    EXPECT_TRUE(children[1]->is<xml::CData>());
+    EXPECT_TRUE(children[2]->is<xml::Comment>());
+    EXPECT_TRUE(children[3]->is<xml::ProcessingInstruction>());
+    EXPECT_TRUE(children[4]->is<xml::Element>());
+    EXPECT_TRUE(root->find_node("@a")->is<xml::Attribute>());
+    EXPECT_FALSE(root->find_node("@a")->is<xml::Content>());
+}
+
+TEST(NodeTest, is_matches_dynamic_cast)
+{
+    xml::Document doc;
+    doc.read_from_string(mixed);
+
+    for (xml::Node* node : doc.get_root_element()->children())
+    {
+        EXPECT_EQ(dynamic_cast<xml::Element*>(node), node->as<xml::Element>());
+        EXPECT_EQ(dynamic_cast<xml::Content*>(node), node->as<xml::Content>());
+        EXPECT_EQ(dynamic_cast<xml::Text*>(node), node->as<xml::Text>());
+        EXPECT_EQ(dynamic_cast<xml::CData*>(node), node->as<xml::CData>());
+        EXPECT_EQ(dynamic_cast<xml::Comment*>(node), node->as<xml::Comment>());
+        EXPECT_EQ(dynamic_cast<xml::ProcessingInstruction*>(node), node->as<xml::ProcessingInstruction>());
+    }
+}
+
+TEST(NodeTest, as)
+{
+    xml::Document doc;
+    doc.read_from_string(mixed);
+    xml::Element* root = doc.get_root_element();
+
+    xml::Node* node = root->find_node("child");
+    EXPECT_EQ(root->find_element("child"), node->as<xml::Element>());
+    EXPECT_TRUE(node->as<xml::Text>() == NULL);
+
+    const xml::Node* cnode = root->find_node("comment()");
+    const xml::Comment* comment = cnode->as<xml::Comment>();
+    ASSERT_TRUE(comment != NULL);
+    EXPECT_EQ("comment", comment->get_content());
+    EXPECT_TRUE(cnode->as<const xml::Element>() == NULL);
+}
@@ -0,0 +1,75 @@
+//
+// Copyright (c) 2008-2020 Sean Farrell
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of
+// this software and associated documentation files (the "Software"), to deal in
+// the Software without restriction, including without limitation the rights to use,
+// copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the
+// Software, and to permit persons to whom the Software is furnished to do so,
+// subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+// INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+// PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+// HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+// OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+// SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+
+#include <string>
+#include <sstream>
+#include <gtest/gtest.h>
+
+#include <libxmlmm/Parser.h>
+#include <libxmlmm/exceptions.h>
+
+TEST(ParserTest, read_many_documents)
+{
+    xml::Parser parser;
+
+    for (int i = 0; i < 100; i++)
+    {
+        std::stringstream xml;
+        xml << "<message id='" << i << "'><body>Message " << i << "</body></message>";
+
+        xml::Document doc;
+        parser.read_from_string(doc, xml.str());
+
+        EXPECT_EQ(i, doc.get_root_element()->get_attribute<int>("id"));
+        EXPECT_EQ("Message " + std::to_string(i), doc.query_string("/message/body"));
+    }
+}
+
+TEST(ParserTest, read_from_buffer)
+{
+    const char buffer[] = "<test>Hello</test>garbage";
+
+    xml::Parser parser;
+    xml::Document doc;
+    parser.read_from_buffer(doc, buffer, 18);
+    EXPECT_EQ("Hello", doc.get_root_element()->get_text());
+}
+
+TEST(ParserTest, recovers_after_invalid_xml)
+{
+    xml::Parser parser;
+    xml::Document doc;
+
+    EXPECT_THROW(parser.read_from_string(doc, "<test><unclosed></test>"), xml::Exception);
+
+    parser.read_from_string(doc, "<test/>");
+    EXPECT_EQ("test", doc.get_root_element()->get_name());
+}
+
+TEST(ParserTest, document_outlives_parser)
+{
+    xml::Document doc;
+    {
+        xml::Parser parser;
+        parser.read_from_string(doc, "<test><child>Hello</child></test>");
+    }
+    EXPECT_EQ("Hello", doc.query_string("/test/child"));
+}
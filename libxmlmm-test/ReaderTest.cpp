@@ -0,0 +1,124 @@
+//
+// Copyright (c) 2008-2020 Sean Farrell
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of
+// this software and associated documentation files (the "Software"), to deal in
+// the Software without restriction, including without limitation the rights to use,
+// copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the
+// Software, and to permit persons to whom the Software is furnished to do so,
+// subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+// INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+// PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+// HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+// OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+// SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+
+#include <string>
+#include <sstream>
+#include <gtest/gtest.h>
+
+#include <libxmlmm/Reader.h>
+#include <libxmlmm/exceptions.h>
+
+static const std::string catalog =
+    "<?xml version='1.0'?>\n"
+    "<catalog>\n"
+    "    <book id='1'><title>Dune</title><year>1965</year></book>\n"
+    "    <book id='2'><title>Neuromancer</title><year>1984</year></book>\n"
+    "    <book id='3'><title>Hyperion</title><year>1989</year></book>\n"
+    "</catalog>\n";
+
+TEST(ReaderTest, read_nodes)
+{
+    xml::Reader reader;
+    reader.open_buffer(catalog.data(), catalog.size());
+
+    ASSERT_TRUE(reader.read());
+    EXPECT_EQ(XML_READER_TYPE_ELEMENT, reader.get_node_type());
+    EXPECT_EQ("catalog", reader.get_name());
+    EXPECT_EQ(0, reader.get_depth());
+
+    unsigned int books = 0;
+    while (reader.read())
+    {
+        if (reader.get_node_type() == XML_READER_TYPE_ELEMENT && reader.get_name() == "book")
+        {
+            EXPECT_EQ(1, reader.get_depth());
+            books++;
+        }
+    }
+    EXPECT_EQ(3, books);
+}
+
+TEST(ReaderTest, get_attribute)
+{
+    xml::Reader reader;
+    reader.open_buffer(catalog.data(), catalog.size());
+
+    while (reader.read() && reader.get_name() != "book") {}
+
+    EXPECT_TRUE(reader.has_attribute("id"));
+    EXPECT_EQ("1", reader.get_attribute("id"));
+    EXPECT_TRUE(! reader.has_attribute("isbn"));
+    EXPECT_THROW(reader.get_attribute("isbn"), xml::NoSuchAttribute);
+}
+
+TEST(ReaderTest, get_value)
+{
+    xml::Reader reader;
+    reader.open_buffer(catalog.data(), catalog.size());
+
+    while (reader.read() && reader.get_name() != "title") {}
+    ASSERT_TRUE(reader.read());
+
+    EXPECT_EQ(XML_READER_TYPE_TEXT, reader.get_node_type());
+    EXPECT_TRUE(reader.has_value());
+    EXPECT_EQ("Dune", reader.get_value());
+}
+
+TEST(ReaderTest, expand_records)
+{
+    std::stringstream is(catalog);
+
+    xml::Reader reader;
+    reader.open_stream(is);
+
+    std::vector<std::string> titles;
+    bool more = reader.read();
+    while (more)
+    {
+        if (reader.get_node_type() == XML_READER_TYPE_ELEMENT && reader.get_name() == "book")
+        {
+            xml::Element* book = reader.expand();
+            ASSERT_TRUE(book != NULL);
+            titles.push_back(book->query_string("title"));
+            EXPECT_EQ(reader.get_attribute("id"), book->get_attribute("id"));
+            more = reader.next();
+        }
+        else
+        {
+            more = reader.read();
+        }
+    }
+
+    ASSERT_EQ(3, titles.size());
+    EXPECT_EQ("Dune", titles[0]);
+    EXPECT_EQ("Neuromancer", titles[1]);
+    EXPECT_EQ("Hyperion", titles[2]);
+}
+
+TEST(ReaderTest, throws_on_invalid_xml)
+{
+    const std::string xml = "<test><unclosed></test>";
+
+    xml::Reader reader;
+    reader.open_buffer(xml.data(), xml.size());
+
+    EXPECT_THROW(while (reader.read()) {}, xml::Exception);
+}
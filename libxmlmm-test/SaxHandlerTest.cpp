@@ -0,0 +1,184 @@
+//
+// Copyright (c) 2008-2020 Sean Farrell
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of
+// this software and associated documentation files (the "Software"), to deal in
+// the Software without restriction, including without limitation the rights to use,
+// copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the
+// Software, and to permit persons to whom the Software is furnished to do so,
+// subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+// INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+// PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+// HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+// OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+// SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+
+#include <string>
+#include <sstream>
+#include <stdexcept>
+#include <gtest/gtest.h>
+
+#include <libxmlmm/SaxHandler.h>
+#include <libxmlmm/exceptions.h>
+
+struct RecordingHandler : public xml::SaxHandler
+{
+    std::vector<std::string> events;
+
+    void start_document() override
+    {
+        events.push_back("start_document");
+    }
+
+    void end_document() override
+    {
+        events.push_back("end_document");
+    }
+
+    void start_element(std::string_view name, const xml::SaxAttributes& attributes) override
+    {
+        std::string event = "<" + std::string(name);
+        for (size_t i = 0; i < attributes.size(); i++)
+        {
+            event += " " + std::string(attributes.get_name(i)) + "=" + std::string(attributes.get_value(i));
+        }
+        events.push_back(event + ">");
+    }
+
+    void end_element(std::string_view name) override
+    {
+        events.push_back("</" + std::string(name) + ">");
+    }
+
+    void characters(std::string_view text) override
+    {
+        events.push_back("text:" + std::string(text));
+    }
+
+    void cdata(std::string_view text) override
+    {
+        events.push_back("cdata:" + std::string(text));
+    }
+
+    void comment(std::string_view text) override
+    {
+        events.push_back("comment:" + std::string(text));
+    }
+};
+
+TEST(SaxHandlerTest, parse_buffer)
+{
+    const std::string xml =
+        "<?xml version='1.0'?>\n"
+        "<root a='1' b='x &amp; y'><!--note--><child>Hello</child><![CDATA[raw]]></root>";
+
+    xml::ParseOptions options;
+    options.substitute_entities = true;
+
+    RecordingHandler handler;
+    handler.parse_buffer(xml.data(), xml.size(), options);
+
+    std::vector<std::string> expected = {
+        "start_document",
+        "<root a=1 b=x & y>",
+        "comment:note",
+        "<child>",
+        "text:Hello",
+        "</child>",
+        "cdata:raw",
+        "</root>",
+        "end_document"
+    };
+    EXPECT_EQ(expected, handler.events);
+}
+
+TEST(SaxHandlerTest, internal_entities)
+{
+    const std::string xml =
+        "<!DOCTYPE x [<!ENTITY e \"v\">]><x a='&e;'>&e;-&e;</x>";
+
+    xml::ParseOptions options;
+    options.substitute_entities = true;
+
+    RecordingHandler handler;
+    handler.parse_buffer(xml.data(), xml.size(), options);
+
+    std::vector<std::string> expected = {
+        "start_document",
+        "<x a=v>",
+        "text:v",
+        "text:-",
+        "text:v",
+        "</x>",
+        "end_document"
+    };
+    EXPECT_EQ(expected, handler.events);
+}
+
+TEST(SaxHandlerTest, references_in_attributes_follow_options)
+{
+    const std::string xml = "<!DOCTYPE x [<!ENTITY e \"v\">]><x a='&e;' b='x &amp; y'>&e;</x>";
+
+    RecordingHandler handler;
+    handler.parse_buffer(xml.data(), xml.size());
+
+    // Without substitution the references in attribute values are kept.
+    ASSERT_EQ(5u, handler.events.size());
+    EXPECT_EQ("<x a=&e; b=x &#38; y>", handler.events[1]);
+    EXPECT_EQ("text:v", handler.events[2]);
+}
+
+struct CountingHandler : public xml::SaxHandler
+{
+    unsigned int items = 0;
+    unsigned int sum = 0;
+
+    void start_element(std::string_view name, const xml::SaxAttributes& attributes) override
+    {
+        if (name == "item")
+        {
+            items++;
+            sum += std::stoi(std::string(attributes.get_attribute("value")));
+        }
+    }
+};
+
+TEST(SaxHandlerTest, parse_stream)
+{
+    std::stringstream xml;
+    xml << "<list>";
+    for (int i = 0; i < 10000; i++)
+    {
+        xml << "<item value='" << i % 10 << "'/>";
+    }
+    xml << "</list>";
+
+    CountingHandler handler;
+    handler.parse_stream(xml);
+
+    EXPECT_EQ(10000, handler.items);
+    EXPECT_EQ(45000, handler.sum);
+}
+
+TEST(SaxHandlerTest, throws_on_invalid_xml)
+{
+    const std::string xml = "<test><unclosed></test>";
+
+    RecordingHandler handler;
+    EXPECT_THROW(handler.parse_buffer(xml.data(), xml.size()), xml::Exception);
+}
+
+TEST(SaxHandlerTest, handler_exception_stops_parse)
+{
+    const std::string xml = "<list><item/><item value='1'/></list>";
+
+    CountingHandler handler;
+    EXPECT_THROW(handler.parse_buffer(xml.data(), xml.size()), xml::NoSuchAttribute);
+    EXPECT_EQ(1, handler.items);
+}
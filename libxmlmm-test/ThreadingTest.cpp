@@ -0,0 +1,204 @@
+//
+// Copyright (c) 2008-2020 Sean Farrell
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of
+// this software and associated documentation files (the "Software"), to deal in
+// the Software without restriction, including without limitation the rights to use,
+// copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the
+// Software, and to permit persons to whom the Software is furnished to do so,
+// subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+// INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+// PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+// HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+// OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+// SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+
+#include <string>
+#include <vector>
+#include <thread>
+#include <atomic>
+#include <gtest/gtest.h>
+
+#include <libxmlmm/Document.h>
+#include <libxmlmm/Parser.h>
+
+static unsigned int get_thread_count()
+{
+    const unsigned int cores = std::thread::hardware_concurrency();
+    return cores < 4 ? 4 : (cores > 16 ? 16 : cores);
+}
+
+// Every thread creates and destroys its own documents, so that libxml is
+// initialized and cleaned up while other threads are parsing.
+TEST(ThreadingTest, parse_on_many_threads)
+{
+    std::atomic<int> failures(0);
+    std::vector<std::thread> threads;
+
+    for (unsigned int t = 0; t < get_thread_count(); t++)
+    {
+        threads.push_back(std::thread([&failures, t] () {
+            for (int i = 0; i < 200; i++)
+            {
+                const std::string id = std::to_string(t) + "-" + std::to_string(i);
+
+                xml::Document doc;
+                doc.read_from_string("<message id='" + id + "'><to>Joe</to><to>Sally</to></message>");
+                if (doc.get_root_element()->get_attribute("id") != id ||
+                    doc.find_elements("/message/to").size() != 2)
+                {
+                    failures++;
+                }
+            }
+        }));
+    }
+
+    for (std::thread& thread : threads)
+    {
+        thread.join();
+    }
+    EXPECT_EQ(0, failures.load());
+}
+
+TEST(ThreadingTest, parser_per_thread)
+{
+    std::atomic<int> failures(0);
+    std::vector<std::thread> threads;
+
+    for (unsigned int t = 0; t < get_thread_count(); t++)
+    {
+        threads.push_back(std::thread([&failures] () {
+            xml::Parser parser;
+            for (int i = 0; i < 200; i++)
+            {
+                xml::Document doc;
+                parser.read_from_string(doc, "<list><item/><item/><item/></list>");
+                if (doc.count("/list/item") != 3)
+                {
+                    failures++;
+                }
+
+                xml::Element* root = doc.get_root_element();
+                root->add_element("item")->set_text(std::to_string(i));
+                if (doc.query_string("/list/item[4]") != std::to_string(i))
+                {
+                    failures++;
+                }
+            }
+        }));
+    }
+
+    for (std::thread& thread : threads)
+    {
+        thread.join();
+    }
+    EXPECT_EQ(0, failures.load());
+}
+
+static void query_shared_document(const bool lazy)
+{
+    xml::set_lazy_wrapping(lazy);
+
+    std::string xml = "<catalog>";
+    for (int i = 0; i < 100; i++)
+    {
+        xml += "<item id='" + std::to_string(i) + "' type='" + (i % 2 ? "odd" : "even") + "'><name>Item " + std::to_string(i) + "</name></item>";
+    }
+    xml += "</catalog>";
+
+    xml::Document tmp;
+    tmp.read_from_string(xml);
+    const xml::Document& doc = tmp;
+
+    const unsigned int count = get_thread_count();
+    std::atomic<int> failures(0);
+    std::vector<std::vector<const xml::Element*> > found(count);
+    std::vector<std::thread> threads;
+
+    for (unsigned int t = 0; t < count; t++)
+    {
+        threads.push_back(std::thread([&doc, &failures, &found, t] () {
+            const xml::XPath odd("/catalog/item[@type='odd']");
+            for (int i = 0; i < 50; i++)
+            {
+                if (doc.find_elements(odd).size() != 50 ||
+                    doc.count("/catalog/item") != 100 ||
+                    !doc.exists("item[@id='42']") ||
+                    doc.query_string("/catalog/item[@id='7']/name") != "Item 7" ||
+                    doc.get_root_element()->get_children().size() != 100)
+                {
+                    failures++;
+                }
+            }
+            for (const xml::Element* item : doc.select_elements("item"))
+            {
+                found[t].push_back(item);
+            }
+        }));
+    }
+
+    for (std::thread& thread : threads)
+    {
+        thread.join();
+    }
+    EXPECT_EQ(0, failures.load());
+
+    // every thread got the same wrappers
+    for (unsigned int t = 1; t < count; t++)
+    {
+        EXPECT_EQ(found[0], found[t]);
+    }
+
+    xml::set_lazy_wrapping(false);
+}
+
+TEST(ThreadingTest, const_queries_on_shared_document)
+{
+    query_shared_document(false);
+}
+
+TEST(ThreadingTest, const_queries_on_shared_document_lazy)
+{
+    query_shared_document(true);
+}
+
+// The XPath contexts of exited threads are freed, the document must not
+// use them any more.
+TEST(ThreadingTest, queries_from_short_lived_threads)
+{
+    xml::Document tmp;
+    tmp.read_from_string("<a:catalog xmlns:a='urn:a'><a:item/><a:item/></a:catalog>");
+    tmp.register_namespace("a", "urn:a");
+    const xml::Document& doc = tmp;
+
+    std::atomic<int> failures(0);
+    for (int i = 0; i < 200; i++)
+    {
+        std::thread thread([&doc, &failures] () {
+            if (doc.count("/a:catalog/a:item") != 2)
+            {
+                failures++;
+            }
+        });
+        thread.join();
+    }
+    EXPECT_EQ(0, failures.load());
+
+    tmp.register_namespace("b", "urn:a");
+    EXPECT_EQ(2, doc.count("/b:catalog/b:item"));
+
+    std::thread thread([&doc, &failures] () {
+        if (doc.count("/b:catalog/a:item") != 2)
+        {
+            failures++;
+        }
+    });
+    thread.join();
+    EXPECT_EQ(0, failures.load());
+}
@@ -0,0 +1,164 @@
+//
+// Copyright (c) 2008-2020 Sean Farrell
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of
+// this software and associated documentation files (the "Software"), to deal in
+// the Software without restriction, including without limitation the rights to use,
+// copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the
+// Software, and to permit persons to whom the Software is furnished to do so,
+// subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+// INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+// PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+// HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+// OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+// SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+
+#include <string>
+#include <vector>
+#include <stdexcept>
+#include <gtest/gtest.h>
+
+#include <libxmlmm/Document.h>
+#include <libxmlmm/Element.h>
+#include <libxmlmm/TreeWalker.h>
+#include <libxmlmm/exceptions.h>
+
+// Records the walk as a string of enter and leave events.
+class RecordingWalker : public xml::TreeWalker
+{
+public:
+    std::string events;
+    std::string skip;
+    std::string stop;
+
+protected:
+    Action enter(xml::Node* node) override
+    {
+        const std::string name = get_label(node);
+        events += "<" + name;
+        if (name == stop)
+        {
+            return STOP;
+        }
+        return name == skip ? SKIP_CHILDREN : CONTINUE;
+    }
+
+    Action leave(xml::Node* node) override
+    {
+        events += ">" + get_label(node);
+        return CONTINUE;
+    }
+
+private:
+    static std::string get_label(xml::Node* node)
+    {
+        xml::Element* element = node->as<xml::Element>();
+        return element != NULL ? element->get_name() : "#" + node->get_value();
+    }
+};
+
+static const std::string tree =
+    "<a><b><c/>t</b><!--x--><d><e/></d></a>";
+
+TEST(TreeWalkerTest, walk_in_order)
+{
+    xml::Document doc;
+    doc.read_from_string(tree);
+
+    RecordingWalker walker;
+    EXPECT_TRUE(walker.walk(doc.get_root_element()));
+    EXPECT_EQ("<a<b<c>c<#t>#t>b<#x>#x<d<e>e>d>a", walker.events);
+}
+
+TEST(TreeWalkerTest, walk_subtree)
+{
+    xml::Document doc;
+    doc.read_from_string(tree);
+
+    RecordingWalker walker;
+    EXPECT_TRUE(walker.walk(doc.find_element("/a/b")));
+    EXPECT_EQ("<b<c>c<#t>#t>b", walker.events);
+}
+
+TEST(TreeWalkerTest, skip_children)
+{
+    xml::Document doc;
+    doc.read_from_string(tree);
+
+    RecordingWalker walker;
+    walker.skip = "b";
+    EXPECT_TRUE(walker.walk(doc.get_root_element()));
+    EXPECT_EQ("<a<b>b<#x>#x<d<e>e>d>a", walker.events);
+}
+
+TEST(TreeWalkerTest, stop)
+{
+    xml::Document doc;
+    doc.read_from_string(tree);
+
+    RecordingWalker walker;
+    walker.stop = "c";
+    EXPECT_FALSE(walker.walk(doc.get_root_element()));
+    EXPECT_EQ("<a<b<c", walker.events);
+}
+
+class ThrowingWalker : public xml::TreeWalker
+{
+protected:
+    Action enter(xml::Node*) override
+    {
+        throw std::runtime_error("enter");
+    }
+};
+
+TEST(TreeWalkerTest, exceptions_are_passed_on)
+{
+    xml::Document doc;
+    doc.read_from_string(tree);
+
+    ThrowingWalker walker;
+    EXPECT_THROW(walker.walk(doc.get_root_element()), std::runtime_error);
+}
+
+class CountingWalker : public xml::TreeWalker
+{
+public:
+    size_t entered = 0;
+    size_t left = 0;
+
+protected:
+    Action enter(xml::Node*) override
+    {
+        entered++;
+        return CONTINUE;
+    }
+
+    Action leave(xml::Node*) override
+    {
+        left++;
+        return CONTINUE;
+    }
+};
+
+TEST(TreeWalkerTest, deep_documents)
+{
+    const size_t depth = 100000;
+
+    xml::Document doc;
+    xml::Element* element = doc.create_root_element("level");
+    for (size_t i = 1; i < depth; i++)
+    {
+        element = element->add_element("level");
+    }
+
+    CountingWalker walker;
+    EXPECT_TRUE(walker.walk(doc.get_root_element()));
+    EXPECT_EQ(depth, walker.entered);
+    EXPECT_EQ(depth, walker.left);
+}
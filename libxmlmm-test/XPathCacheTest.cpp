@@ -0,0 +1,125 @@
+//
+// Copyright (c) 2008-2020 Sean Farrell
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of
+// this software and associated documentation files (the "Software"), to deal in
+// the Software without restriction, including without limitation the rights to use,
+// copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the
+// Software, and to permit persons to whom the Software is furnished to do so,
+// subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+// INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+// PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+// HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+// OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+// SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+
+#include <string>
+#include <gtest/gtest.h>
+
+#include <libxmlmm/Document.h>
+#include <libxmlmm/XPathCache.h>
+#include <libxmlmm/exceptions.h>
+
+static const std::string message =
+    "<?xml version='1.0'?>\n"
+    "<message version=\"1.2\">\n"
+    "    <from>Mack</from>\n"
+    "    <to>Joe</to>\n"
+    "    <to>Sally</to>\n"
+    "    <body>Hello everybody!</body>\n"
+    "</message>\n";
+
+class XPathCacheTest : public testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        xml::XPathCache::clear();
+        xml::XPathCache::set_capacity(2);
+    }
+
+    void TearDown() override
+    {
+        xml::XPathCache::set_capacity(0);
+        xml::XPathCache::clear();
+    }
+};
+
+TEST_F(XPathCacheTest, disabled_by_default)
+{
+    xml::XPathCache::set_capacity(0);
+    EXPECT_EQ(0, xml::XPathCache::get_capacity());
+
+    xml::Document doc;
+    doc.read_from_string(message);
+    EXPECT_EQ("Mack", doc.query_string("/message/from"));
+
+    xml::XPathCache::Statistics stats = xml::XPathCache::get_statistics();
+    EXPECT_EQ(0, stats.hits);
+    EXPECT_EQ(0, stats.misses);
+    EXPECT_EQ(0, stats.size);
+}
+
+TEST_F(XPathCacheTest, queries_hit_the_cache)
+{
+    xml::Document doc;
+    doc.read_from_string(message);
+
+    for (int i = 0; i < 3; i++)
+    {
+        EXPECT_EQ(2, doc.find_elements("/message/to").size());
+    }
+
+    xml::XPathCache::Statistics stats = xml::XPathCache::get_statistics();
+    EXPECT_EQ(2, stats.hits);
+    EXPECT_EQ(1, stats.misses);
+    EXPECT_EQ(0, stats.evictions);
+    EXPECT_EQ(1, stats.size);
+}
+
+TEST_F(XPathCacheTest, evicts_least_recently_used)
+{
+    std::shared_ptr<const xml::XPath> from = xml::XPathCache::get("/message/from");
+    xml::XPathCache::get("/message/to");
+    xml::XPathCache::get("/message/from");
+    xml::XPathCache::get("/message/body");
+
+    xml::XPathCache::Statistics stats = xml::XPathCache::get_statistics();
+    EXPECT_EQ(1, stats.hits);
+    EXPECT_EQ(3, stats.misses);
+    EXPECT_EQ(1, stats.evictions);
+    EXPECT_EQ(2, stats.size);
+
+    // "/message/to" was evicted, "/message/from" was kept
+    EXPECT_EQ(from, xml::XPathCache::get("/message/from"));
+    xml::XPathCache::get("/message/to");
+    stats = xml::XPathCache::get_statistics();
+    EXPECT_EQ(2, stats.hits);
+    EXPECT_EQ(4, stats.misses);
+}
+
+TEST_F(XPathCacheTest, shrinking_evicts)
+{
+    xml::XPathCache::get("/message/from");
+    xml::XPathCache::get("/message/to");
+    xml::XPathCache::set_capacity(1);
+
+    xml::XPathCache::Statistics stats = xml::XPathCache::get_statistics();
+    EXPECT_EQ(1, stats.evictions);
+    EXPECT_EQ(1, stats.size);
+}
+
+TEST_F(XPathCacheTest, invalid_xpath)
+{
+    xml::Document doc;
+    doc.read_from_string(message);
+
+    EXPECT_THROW(doc.find_nodes("/message/[to"), xml::InvalidXPath);
+    EXPECT_EQ(0, xml::XPathCache::get_statistics().size);
+}
@@ -0,0 +1,195 @@
+//
+// Copyright (c) 2008-2020 Sean Farrell
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of
+// this software and associated documentation files (the "Software"), to deal in
+// the Software without restriction, including without limitation the rights to use,
+// copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the
+// Software, and to permit persons to whom the Software is furnished to do so,
+// subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+// INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+// PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+// HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+// OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+// SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+
+#include <string>
+#include <thread>
+#include <gtest/gtest.h>
+
+#include <libxmlmm/Document.h>
+#include <libxmlmm/XPath.h>
+#include <libxmlmm/exceptions.h>
+
+static const std::string message =
+    "<?xml version='1.0'?>\n"
+    "<message version=\"1.2\">\n"
+    "    <from>Mack</from>\n"
+    "    <to>Joe</to>\n"
+    "    <to>Sally</to>\n"
+    "    <to>Mike</to>\n"
+    "    <body>Hello everybody!</body>\n"
+    "</message>\n";
+
+TEST(XPathTest, compile)
+{
+    xml::XPath xpath("/message/to");
+    EXPECT_EQ("/message/to", xpath.get_expression());
+}
+
+TEST(XPathTest, compile_throws_on_invalid_xpath)
+{
+    EXPECT_THROW(xml::XPath("/message/[to"), xml::InvalidXPath);
+}
+
+TEST(XPathTest, document_queries)
+{
+    xml::Document doc;
+    doc.read_from_string(message);
+
+    const xml::XPath to("/message/to");
+    const xml::XPath from("/message/from");
+    const xml::XPath count("count(/message/to)");
+    const xml::XPath version("/message/@version");
+
+    EXPECT_EQ(3, doc.find_nodes(to).size());
+    ASSERT_EQ(3, doc.find_elements(to).size());
+    EXPECT_EQ("Sally", doc.find_elements(to)[1]->get_text());
+    EXPECT_TRUE(doc.find_node(from) != NULL);
+    EXPECT_EQ("Mack", doc.find_element(from)->get_text());
+    EXPECT_FLOAT_EQ(3.0, doc.query_number(count));
+    EXPECT_EQ("1.2", doc.query_string(version));
+}
+
+TEST(XPathTest, reuse_across_documents)
+{
+    const xml::XPath body("body");
+
+    for (int i = 0; i < 10; i++)
+    {
+        xml::Document doc;
+        doc.read_from_string("<message><body>" + std::to_string(i) + "</body></message>");
+
+        const xml::Element* root = doc.get_root_element();
+        EXPECT_EQ(std::to_string(i), root->query_string(body));
+        EXPECT_EQ(root, root->find_element(body)->get_parent());
+    }
+}
+
+TEST(XPathTest, register_namespace)
+{
+    xml::Document doc;
+    doc.read_from_string(
+        "<catalog xmlns='urn:books'>"
+        "<book id='1'>Dune</book>"
+        "<book id='2'>Neuromancer</book>"
+        "</catalog>");
+
+    EXPECT_EQ(0, doc.find_elements("/catalog/book").size());
+
+    doc.register_namespace("b", "urn:books");
+    EXPECT_EQ(2, doc.find_elements("/b:catalog/b:book").size());
+    EXPECT_EQ("Dune", doc.get_root_element()->query_string("b:book[@id='1']"));
+}
+
+TEST(XPathTest, register_variable)
+{
+    xml::Document doc;
+    doc.read_from_string(message);
+
+    doc.register_variable("name", "Sally");
+    doc.register_variable("index", 3.0);
+
+    EXPECT_TRUE(doc.find_element("/message/to[text()=$name]") != NULL);
+    EXPECT_EQ("Mike", doc.query_string("/message/to[$index]"));
+
+    // registrations survive reading a new document
+    doc.read_from_string(message);
+    EXPECT_EQ("Mike", doc.query_string("/message/to[$index]"));
+}
+
+TEST(XPathTest, context_per_thread)
+{
+    xml::Document doc;
+    doc.read_from_string(message);
+    doc.register_variable("name", "Joe");
+
+    std::string result;
+    std::thread worker([&] () {
+        result = doc.query_string("/message/to[text()=$name]");
+    });
+    worker.join();
+
+    EXPECT_EQ("Joe", result);
+    EXPECT_EQ("Joe", doc.query_string("/message/to[text()=$name]"));
+}
+
+TEST(XPathTest, simple_paths_match_libxml)
+{
+    xml::Document doc;
+    doc.read_from_string(
+        "<?xml version='1.0'?>\n"
+        "<!DOCTYPE catalog [<!ENTITY kind 'book'>]>\n"
+        "<catalog xmlns:x='urn:x'>"
+        "<item id='1' type='book'><name>Dune</name><tag>a</tag></item>"
+        "<item id='2' type='cd'><name>Kind of Blue</name></item>"
+        "<item id='3' type='&kind;'><name>Neuromancer</name></item>"
+        "<item id='4' x:type='book' type=''><name/></item>"
+        "<x:item id='5' type='book'><name>Hidden</name></x:item>"
+        "<other>text<item id='6'/></other>"
+        "</catalog>");
+    const xml::Element* root = doc.get_root_element();
+
+    const char* expressions[] = {
+        ".", "./item", "item", "item/name", "./item/./name", "*", "*/name",
+        "@id", "item/@id", "item/@*", "*/*", "item[@type]",
+        "item[@type='book']", "item[@type=\"cd\"]", "item[@type='']",
+        "item[@type='book']/name", "item[@id='4']/@type", "missing/name",
+        "other/item", "item[@id='3']"
+    };
+
+    for (const char* expression : expressions)
+    {
+        const xml::XPath compiled(expression);
+        const std::vector<const xml::Node*> expected = root->find_nodes(compiled);
+        EXPECT_EQ(expected, root->find_nodes(expression)) << expression;
+    }
+
+    EXPECT_EQ(1, root->find_elements("item[@type='cd']").size());
+    EXPECT_EQ("Kind of Blue", root->query_string("item[@type='cd']/name"));
+    EXPECT_EQ(root, root->find_node("."));
+    EXPECT_EQ("1", root->find_element("item")->find_node("@id")->get_value());
+}
+
+TEST(XPathTest, exists_and_count)
+{
+    xml::Document doc;
+    doc.read_from_string(message);
+    const xml::Element* root = doc.get_root_element();
+
+    EXPECT_TRUE(doc.exists("/message/to"));
+    EXPECT_FALSE(doc.exists("/message/cc"));
+    EXPECT_TRUE(root->exists("to"));
+    EXPECT_TRUE(root->exists("@version"));
+    EXPECT_FALSE(root->exists("to[@id]"));
+    EXPECT_TRUE(root->exists(xml::XPath("to[. = 'Sally']")));
+    EXPECT_FALSE(root->exists(xml::XPath("to[. = 'Bob']")));
+
+    EXPECT_EQ(3, doc.count("/message/to"));
+    EXPECT_EQ(0, doc.count("/message/cc"));
+    EXPECT_EQ(3, root->count("to"));
+    EXPECT_EQ(2, root->count(xml::XPath("from | body")));
+
+    EXPECT_THROW(doc.exists("/message/[to"), xml::InvalidXPath);
+    EXPECT_THROW(doc.count("count(/message/to)"), xml::Exception);
+
+    xml::Document empty;
+    EXPECT_THROW(empty.exists("to"), xml::EmptyDocument);
+    EXPECT_THROW(empty.count("to"), xml::EmptyDocument);
+}
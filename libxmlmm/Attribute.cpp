@@ -31,12 +31,7 @@ namespace xml
 
     std::string Attribute::get_value() const
     {
-        const char *const ptr = reinterpret_cast<const char*>(xmlGetProp(cobj->parent, cobj->name));
-        if (ptr)
-        {
-            return ptr;
-        }
-        return "";
+        return get_attribute_value(reinterpret_cast<const xmlAttr*>(cobj));
     }
 
 
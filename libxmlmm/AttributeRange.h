@@ -0,0 +1,198 @@
+//
+// Copyright (c) 2008-2020 Sean Farrell
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of
+// this software and associated documentation files (the "Software"), to deal in
+// the Software without restriction, including without limitation the rights to use,
+// copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the
+// Software, and to permit persons to whom the Software is furnished to do so,
+// subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+// INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+// PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+// HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+// OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+// SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+
+#pragma once
+
+#include <iterator>
+#include <string>
+#include <string_view>
+#include <libxml/tree.h>
+
+#include "defines.h"
+#include "exceptions.h"
+#include "utils.h"
+
+namespace xml
+{
+    /**
+     * Range over the Attributes of an Element
+     *
+     * The range walks the attribute list of the element in place and
+     * yields light weight entries that give access to the name and value
+     * of each attribute, no wrappers are created and nothing is
+     * allocated.
+     *
+     * @code
+     * for (const xml::AttributeRange::Entry& attribute : element->attributes())
+     * {
+     *     std::cout << attribute.get_name() << "=" << attribute.get_value() << std::endl;
+     * }
+     * @endcode
+     **/
+    class AttributeRange
+    {
+    public:
+        /**
+         * Name and value of one attribute.
+         **/
+        class Entry
+        {
+        public:
+            explicit Entry(const xmlAttr* cobj)
+            : cobj(cobj) {}
+
+            /**
+             * Get the attribute's name.
+             **/
+            std::string_view get_name() const
+            {
+                return reinterpret_cast<const char*>(cobj->name);
+            }
+
+            /**
+             * Get the attribute's value.
+             **/
+            std::string get_value() const
+            {
+                return get_attribute_value(cobj);
+            }
+
+            /**
+             * Get the attribute's value without copying it.
+             *
+             * @throws Exception if the value is not stored as one string in
+             * the document.
+             *
+             * @see Element::get_attribute_view
+             **/
+            std::string_view get_value_view() const
+            {
+                std::string_view value;
+                if (!get_attribute_view(cobj, value))
+                {
+                    throw Exception("The value of attribute " + std::string(get_name()) + " is not stored as one string.");
+                }
+                return value;
+            }
+
+            /**
+             * Get the wrapped xmlAttr.
+             **/
+            const xmlAttr* get_cobj() const
+            {
+                return cobj;
+            }
+
+        private:
+            const xmlAttr* cobj;
+        };
+
+        /**
+         * Iterator over the attributes of the range.
+         **/
+        class iterator
+        {
+        public:
+            typedef std::forward_iterator_tag iterator_category;
+            typedef Entry value_type;
+            typedef std::ptrdiff_t difference_type;
+            typedef const Entry* pointer;
+            typedef const Entry& reference;
+
+            iterator()
+            : entry(NULL) {}
+
+            explicit iterator(const xmlAttr* attr)
+            : entry(attr) {}
+
+            const Entry& operator * () const
+            {
+                return entry;
+            }
+
+            const Entry* operator -> () const
+            {
+                return &entry;
+            }
+
+            iterator& operator ++ ()
+            {
+                entry = Entry(entry.get_cobj()->next);
+                return *this;
+            }
+
+            iterator operator ++ (int)
+            {
+                iterator tmp(*this);
+                ++(*this);
+                return tmp;
+            }
+
+            bool operator == (const iterator& other) const
+            {
+                return entry.get_cobj() == other.entry.get_cobj();
+            }
+
+            bool operator != (const iterator& other) const
+            {
+                return entry.get_cobj() != other.entry.get_cobj();
+            }
+
+        private:
+            Entry entry;
+        };
+
+        /**
+         * Create a range starting at the given attribute.
+         *
+         * @param first The first attribute of an element, may be NULL.
+         **/
+        explicit AttributeRange(const xmlAttr* first)
+        : first(first) {}
+
+        /**
+         * Check if the range is empty.
+         **/
+        bool empty() const
+        {
+            return first == NULL;
+        }
+
+        /**
+         * Get an iterator to the first attribute.
+         **/
+        iterator begin() const
+        {
+            return iterator(first);
+        }
+
+        /**
+         * Get an iterator past the last attribute.
+         **/
+        iterator end() const
+        {
+            return iterator();
+        }
+
+    private:
+        const xmlAttr* first;
+    };
+}
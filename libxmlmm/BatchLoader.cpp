@@ -0,0 +1,264 @@
+//
+// Copyright (c) 2008-2020 Sean Farrell
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of
+// this software and associated documentation files (the "Software"), to deal in
+// the Software without restriction, including without limitation the rights to use,
+// copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the
+// Software, and to permit persons to whom the Software is furnished to do so,
+// subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+// INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+// PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+// HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+// OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+// SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+
+#include "BatchLoader.h"
+
+#include <algorithm>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <atomic>
+#include <condition_variable>
+
+#include "Parser.h"
+
+namespace xml
+{
+    // A worker's share of the batch. The owner takes tasks from the front,
+    // idle workers steal from the back.
+    struct WorkQueue
+    {
+        std::mutex         mutex;
+        std::deque<size_t> tasks;
+    };
+
+    // Results handed from the workers to the loading thread.
+    struct Completion
+    {
+        std::mutex                          mutex;
+        std::condition_variable             ready;
+        std::deque<BatchLoader::Result>     results;
+        size_t                              running;
+    };
+
+    static bool next_task(std::vector<WorkQueue>& queues, const size_t self, size_t& task)
+    {
+        {
+            WorkQueue& own = queues[self];
+            std::lock_guard<std::mutex> lock(own.mutex);
+            if (!own.tasks.empty())
+            {
+                task = own.tasks.front();
+                own.tasks.pop_front();
+                return true;
+            }
+        }
+
+        for (size_t i = 1; i < queues.size(); i++)
+        {
+            WorkQueue& victim = queues[(self + i) % queues.size()];
+            std::lock_guard<std::mutex> lock(victim.mutex);
+            if (!victim.tasks.empty())
+            {
+                task = victim.tasks.back();
+                victim.tasks.pop_back();
+                return true;
+            }
+        }
+        return false;
+    }
+
+
+    BatchLoader::BatchLoader(unsigned int t)
+    : threads(t)
+    {
+        if (threads == 0)
+        {
+            threads = std::thread::hardware_concurrency();
+        }
+        if (threads == 0)
+        {
+            threads = 1;
+        }
+    }
+
+
+    unsigned int BatchLoader::get_thread_count() const
+    {
+        return threads;
+    }
+
+
+    std::vector<BatchLoader::Result> BatchLoader::load_files(const std::vector<std::string>& files, const ParseOptions& options)
+    {
+        std::vector<Result> results;
+        results.reserve(files.size());
+        load_files(files, [&results] (Result& result) {
+            results.push_back(std::move(result));
+        }, options);
+        return results;
+    }
+
+
+    void BatchLoader::load_files(const std::vector<std::string>& files, const Callback& callback, const ParseOptions& options)
+    {
+        run(files.size(), [&files, &options] (Parser& parser, Document& doc, size_t index) {
+            parser.read_from_file(doc, files[index], options);
+        }, callback);
+    }
+
+
+    std::vector<BatchLoader::Result> BatchLoader::load_buffers(const std::vector<std::string_view>& buffers, const ParseOptions& options)
+    {
+        std::vector<Result> results;
+        results.reserve(buffers.size());
+        load_buffers(buffers, [&results] (Result& result) {
+            results.push_back(std::move(result));
+        }, options);
+        return results;
+    }
+
+
+    void BatchLoader::load_buffers(const std::vector<std::string_view>& buffers, const Callback& callback, const ParseOptions& options)
+    {
+        run(buffers.size(), [&buffers, &options] (Parser& parser, Document& doc, size_t index) {
+            parser.read_from_buffer(doc, buffers[index], options);
+        }, callback);
+    }
+
+
+    void BatchLoader::run(size_t count, const Task& task, const Callback& callback)
+    {
+        if (count == 0)
+        {
+            return;
+        }
+
+        const size_t workers = std::min<size_t>(threads, count);
+        std::vector<WorkQueue> queues(workers);
+        for (size_t i = 0; i < count; i++)
+        {
+            queues[i * workers / count].tasks.push_back(i);
+        }
+
+        Completion completion;
+        completion.running = workers;
+        std::atomic<bool> stop(false);
+
+        std::function<void (size_t)> work = [&] (size_t self) {
+            // Each worker reuses one parser context for all its documents.
+            std::unique_ptr<Parser> parser;
+            std::string parser_error;
+            try
+            {
+                parser.reset(new Parser);
+            }
+            catch (const std::exception& ex)
+            {
+                parser_error = ex.what();
+            }
+
+            size_t index;
+            while (!stop.load(std::memory_order_relaxed) && next_task(queues, self, index))
+            {
+                Result result;
+                result.index = index;
+                if (parser)
+                {
+                    try
+                    {
+                        std::unique_ptr<Document> doc(new Document);
+                        task(*parser, *doc, index);
+                        result.document = std::move(doc);
+                    }
+                    catch (const std::exception& ex)
+                    {
+                        result.error = ex.what();
+                    }
+                }
+                else
+                {
+                    result.error = parser_error;
+                }
+
+                std::lock_guard<std::mutex> lock(completion.mutex);
+                completion.results.push_back(std::move(result));
+                completion.ready.notify_one();
+            }
+
+            std::lock_guard<std::mutex> lock(completion.mutex);
+            completion.running--;
+            completion.ready.notify_one();
+        };
+
+        std::vector<std::thread> pool;
+        pool.reserve(workers);
+        std::exception_ptr error;
+        try
+        {
+            for (size_t i = 0; i < workers; i++)
+            {
+                pool.push_back(std::thread(work, i));
+            }
+        }
+        catch (...)
+        {
+            error = std::current_exception();
+            stop = true;
+            std::lock_guard<std::mutex> lock(completion.mutex);
+            completion.running -= workers - pool.size();
+        }
+
+        // Pass on results as they come in, the callback runs on this thread.
+        std::unique_lock<std::mutex> lock(completion.mutex);
+        while (true)
+        {
+            completion.ready.wait(lock, [&completion] () {
+                return !completion.results.empty() || completion.running == 0;
+            });
+            if (completion.results.empty())
+            {
+                break;
+            }
+
+            std::deque<Result> results;
+            results.swap(completion.results);
+            lock.unlock();
+            if (!error)
+            {
+                try
+                {
+                    for (size_t i = 0; i < results.size(); i++)
+                    {
+                        callback(results[i]);
+                    }
+                }
+                catch (...)
+                {
+                    error = std::current_exception();
+                    stop = true;
+                }
+            }
+            lock.lock();
+        }
+        lock.unlock();
+
+        for (size_t i = 0; i < pool.size(); i++)
+        {
+            pool[i].join();
+        }
+
+        if (error)
+        {
+            std::rethrow_exception(error);
+        }
+    }
+}
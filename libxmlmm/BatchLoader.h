@@ -0,0 +1,148 @@
+//
+// Copyright (c) 2008-2020 Sean Farrell
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of
+// this software and associated documentation files (the "Software"), to deal in
+// the Software without restriction, including without limitation the rights to use,
+// copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the
+// Software, and to permit persons to whom the Software is furnished to do so,
+// subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+// INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+// PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+// HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+// OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+// SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <memory>
+#include <functional>
+
+#include "defines.h"
+#include "LibXmlSentry.h"
+#include "ParseOptions.h"
+#include "Document.h"
+
+namespace xml
+{
+    class Parser;
+
+    /**
+     * Parallel Document Loader
+     *
+     * The BatchLoader parses a list of files or buffers on a pool of worker
+     * threads. The work is split evenly among the workers up front; a
+     * worker that runs out of work steals from the others, so that a few
+     * large documents do not leave the other workers idle.
+     *
+     * Results are reported in completion order, not in input order. A
+     * document that fails to load does not stop the batch, the error is
+     * reported in its result.
+     *
+     * @code
+     * xml::BatchLoader loader;
+     * loader.load_files(paths, [&] (xml::BatchLoader::Result& result) {
+     *     if (result.document)
+     *     {
+     *         process(paths[result.index], *result.document);
+     *     }
+     *     else
+     *     {
+     *         std::cerr << paths[result.index] << ": " << result.error << std::endl;
+     *     }
+     * });
+     * @endcode
+     **/
+    class LIBXMLMM_EXPORT BatchLoader
+    {
+    public:
+        /**
+         * The Result of Loading one Document
+         **/
+        struct Result
+        {
+            /** The position of the file or buffer in the input list. **/
+            size_t index;
+            /** The loaded document or NULL if loading failed. **/
+            std::unique_ptr<Document> document;
+            /** The error message if loading failed. **/
+            std::string error;
+        };
+
+        /**
+         * Callback that receives each result as it completes.
+         *
+         * The callback is always invoked on the thread that called load,
+         * never concurrently.
+         **/
+        typedef std::function<void (Result&)> Callback;
+
+        /**
+         * Constructor
+         *
+         * @param threads The number of worker threads, 0 to use one per
+         * hardware thread.
+         **/
+        explicit BatchLoader(unsigned int threads = 0);
+
+        /**
+         * Get the number of worker threads.
+         **/
+        unsigned int get_thread_count() const;
+
+        /**
+         * Load documents from files.
+         *
+         * @param files The files to load.
+         * @param callback The callback to pass results to.
+         * @param options The parser options.
+         *
+         * @return The results in completion order.
+         *
+         * @note If the callback throws, the remaining documents are not
+         * loaded and the exception is passed on.
+         *
+         * @{
+         **/
+        std::vector<Result> load_files(const std::vector<std::string>& files, const ParseOptions& options = ParseOptions());
+        void load_files(const std::vector<std::string>& files, const Callback& callback, const ParseOptions& options = ParseOptions());
+        /** @} **/
+
+        /**
+         * Load documents from memory buffers.
+         *
+         * @param buffers The xml data, the buffers must stay valid until
+         * the load returns.
+         * @param callback The callback to pass results to.
+         * @param options The parser options.
+         *
+         * @return The results in completion order.
+         *
+         * @{
+         **/
+        std::vector<Result> load_buffers(const std::vector<std::string_view>& buffers, const ParseOptions& options = ParseOptions());
+        void load_buffers(const std::vector<std::string_view>& buffers, const Callback& callback, const ParseOptions& options = ParseOptions());
+        /** @} **/
+
+    private:
+        LibXmlSentry libxml_sentry;
+
+        unsigned int threads;
+
+        typedef std::function<void (Parser&, Document&, size_t)> Task;
+
+        void run(size_t count, const Task& task, const Callback& callback);
+
+        BatchLoader(const BatchLoader&);
+        BatchLoader& operator = (const BatchLoader&);
+    };
+}
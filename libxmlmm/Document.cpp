@@ -21,19 +21,105 @@
 
 #include "Document.h"
 
+#include <atomic>
+#include <mutex>
+#include <vector>
+#include <algorithm>
 #include <libxml/tree.h>
+#include <libxml/xpathInternals.h>
 
 #include "utils.h"
 #include "exceptions.h"
+#include "MappedFile.h"
 
 namespace xml
 {
 
 
+    // The calling thread's most recently used XPath contexts. Entries of
+    // freed contexts are never hit again, since generations are not reused.
+    struct XPathContextCacheEntry
+    {
+        unsigned long long generation;
+        xmlXPathContext*   ctxt;
+    };
+
+    static const size_t xpath_context_cache_size = 4;
+    static thread_local XPathContextCacheEntry xpath_context_cache[xpath_context_cache_size];
+    static thread_local size_t xpath_context_cache_next;
+
+    static void remember_xpath_context(const unsigned long long generation, xmlXPathContext* const ctxt)
+    {
+        xpath_context_cache[xpath_context_cache_next] = XPathContextCacheEntry{generation, ctxt};
+        xpath_context_cache_next = (xpath_context_cache_next + 1) % xpath_context_cache_size;
+    }
+
+    struct ThreadXPathContexts;
+
+    // A document's XPath context for one thread. It is listed by both,
+    // and freed by the document or when the thread exits.
+    struct XPathContextEntry
+    {
+        xmlXPathContext*                 ctxt;
+        unsigned long long               generation;
+        std::vector<XPathContextEntry*>* document;
+        ThreadXPathContexts*             thread;
+    };
+
+    // Guards all entries and the lists that hold them. It is leaked, so
+    // that documents can still be freed during static destruction.
+    static std::mutex& get_xpath_mutex()
+    {
+        static std::mutex* mutex = new std::mutex();
+        return *mutex;
+    }
+
+    static void remove_entry(std::vector<XPathContextEntry*>& entries, XPathContextEntry* const entry)
+    {
+        std::vector<XPathContextEntry*>::iterator i = std::find(entries.begin(), entries.end(), entry);
+        if (i != entries.end())
+        {
+            *i = entries.back();
+            entries.pop_back();
+        }
+    }
+
+    // The contexts the calling thread created, freed when it exits.
+    struct ThreadXPathContexts
+    {
+        std::vector<XPathContextEntry*> entries;
+
+        ~ThreadXPathContexts();
+    };
+
+    static thread_local ThreadXPathContexts thread_xpath_contexts;
+    static thread_local bool thread_xpath_contexts_alive = true;
+
+    ThreadXPathContexts::~ThreadXPathContexts()
+    {
+        std::lock_guard<std::mutex> lock(get_xpath_mutex());
+        for (size_t i = 0; i < entries.size(); i++)
+        {
+            remove_entry(*entries[i]->document, entries[i]);
+            xmlXPathFreeContext(entries[i]->ctxt);
+            delete entries[i];
+        }
+        entries.clear();
+        thread_xpath_contexts_alive = false;
+    }
+
+    static unsigned long long new_xpath_generation()
+    {
+        static std::atomic<unsigned long long> next_generation(1);
+        return next_generation.fetch_add(1, std::memory_order_relaxed);
+    }
+
+
     Document::Document()
     : cobj(xmlNewDoc(BAD_CAST "1.0"))
     {
         cobj->_private = this;
+        xpath_generation = new_xpath_generation();
     }
 
 
@@ -41,12 +127,18 @@ namespace xml
     : cobj(xmlNewDoc(BAD_CAST "1.0"))
     {
         cobj->_private = this;
+        xpath_generation = new_xpath_generation();
         this->read_from_string(xml);
     }
 
 
     Document::~Document()
     {
+        free_xpath_contexts();
+        for (size_t i = 0; i < xpath_variables.size(); i++)
+        {
+            xmlXPathFreeObject(xpath_variables[i].second);
+        }
         xmlFreeDoc(cobj);
     }
 
@@ -64,7 +156,7 @@ namespace xml
         {
             throw NoRootElement();
         }
-        return reinterpret_cast<Element*>(root->_private);
+        return static_cast<Element*>(get_wrapper(root));
     }
 
 
@@ -89,7 +181,7 @@ namespace xml
 
         xmlDocSetRootElement(cobj, root);
 
-        return reinterpret_cast<Element*>(root->_private);
+        return static_cast<Element*>(get_wrapper(root));
     }
 
 
@@ -161,37 +253,96 @@ namespace xml
     }
 
 
-    void Document::read_from_string(const std::string& xml)
+    void Document::read_from_string(const std::string& xml, const ParseOptions& options)
     {
-        xmlDoc* tmp_cobj = xmlReadDoc(reinterpret_cast<const xmlChar*>(xml.c_str()), NULL, NULL, 0);
-        if (tmp_cobj == NULL)
+        read_from_buffer(xml.data(), xml.size(), options);
+    }
+
+
+    void Document::read_from_buffer(const char* data, size_t size, const ParseOptions& options)
+    {
+        replace(read_memory(data, size, NULL, options.get_flags()));
+    }
+
+
+    void Document::read_from_buffer(std::string_view xml, const ParseOptions& options)
+    {
+        read_from_buffer(xml.data(), xml.size(), options);
+    }
+
+
+    void Document::read_from_stream(std::istream& is, const ParseOptions& options)
+    {
+        replace(read_stream(is, NULL, options.get_flags()));
+    }
+
+
+    void Document::read_from_file(const std::string& file, const ParseOptions& options)
+    {
+        replace(xmlReadFile(file.c_str(), NULL, options.get_flags()));
+    }
+
+
+    void Document::read_from_file_mapped(const std::string& file, const ParseOptions& options)
+    {
+        MappedFile mapping(file);
+        replace(read_memory(mapping.get_data(), mapping.get_size(), file.c_str(), options.get_flags()));
+    }
+
+
+    Node* Document::find_node(const std::string& xpath)
+    {
+        try
         {
-            throw Exception(get_last_error());
+            return get_root_element()->find_node(xpath);
+        }
+        catch (const NoRootElement &)
+        {
+            throw EmptyDocument();
         }
-            xmlFreeDoc(cobj);
-            cobj = tmp_cobj;
+    }
+
+
+    Node* Document::find_node(const char* xpath)
+    {
+        try
+        {
+            return get_root_element()->find_node(xpath);
+        }
+        catch (const NoRootElement &)
+        {
+            throw EmptyDocument();
         }
+    }
 
 
-    void Document::read_from_stream(std::istream& is)
+    Node* Document::find_node(std::string_view xpath)
     {
-        read_from_string(read_until_eof(is));
+        try
+        {
+            return get_root_element()->find_node(xpath);
+        }
+        catch (const NoRootElement &)
+        {
+            throw EmptyDocument();
+        }
     }
 
 
-    void Document::read_from_file(const std::string& file)
+    const Node* Document::find_node(const std::string& xpath) const
     {
-        xmlDoc* tmp_cobj = xmlReadFile(file.c_str(), NULL, 0);
-        if (tmp_cobj == NULL)
+        try
         {
-            throw Exception(get_last_error());
+            return get_root_element()->find_node(xpath);
+        }
+        catch (const NoRootElement &)
+        {
+            throw EmptyDocument();
         }
-        xmlFreeDoc(cobj);
-        cobj = tmp_cobj;
     }
 
 
-    Node* Document::find_node(const std::string& xpath)
+    const Node* Document::find_node(const char* xpath) const
     {
         try
         {
@@ -204,7 +355,7 @@ namespace xml
     }
 
 
-    const Node* Document::find_node(const std::string& xpath) const
+    const Node* Document::find_node(std::string_view xpath) const
     {
         try
         {
@@ -230,6 +381,32 @@ namespace xml
     }
 
 
+    std::vector<Node*> Document::find_nodes(const char* xpath)
+    {
+        try
+        {
+            return get_root_element()->find_nodes(xpath);
+        }
+        catch (const NoRootElement &)
+        {
+            throw EmptyDocument();
+        }
+    }
+
+
+    std::vector<Node*> Document::find_nodes(std::string_view xpath)
+    {
+        try
+        {
+            return get_root_element()->find_nodes(xpath);
+        }
+        catch (const NoRootElement &)
+        {
+            throw EmptyDocument();
+        }
+    }
+
+
     std::vector<const Node*> Document::find_nodes(const std::string& xpath) const
     {
         try
@@ -243,6 +420,32 @@ namespace xml
     }
 
 
+    std::vector<const Node*> Document::find_nodes(const char* xpath) const
+    {
+        try
+        {
+            return get_root_element()->find_nodes(xpath);
+        }
+        catch (const NoRootElement &)
+        {
+            throw EmptyDocument();
+        }
+    }
+
+
+    std::vector<const Node*> Document::find_nodes(std::string_view xpath) const
+    {
+        try
+        {
+            return get_root_element()->find_nodes(xpath);
+        }
+        catch (const NoRootElement &)
+        {
+            throw EmptyDocument();
+        }
+    }
+
+
     Element* Document::find_element(const std::string& xpath)
     {
         try
@@ -256,6 +459,32 @@ namespace xml
     }
 
 
+    Element* Document::find_element(const char* xpath)
+    {
+        try
+        {
+            return get_root_element()->find_element(xpath);
+        }
+        catch (const NoRootElement &)
+        {
+            throw EmptyDocument();
+        }
+    }
+
+
+    Element* Document::find_element(std::string_view xpath)
+    {
+        try
+        {
+            return get_root_element()->find_element(xpath);
+        }
+        catch (const NoRootElement &)
+        {
+            throw EmptyDocument();
+        }
+    }
+
+
     const Element* Document::find_element(const std::string& xpath) const
     {
         try
@@ -269,6 +498,32 @@ namespace xml
     }
 
 
+    const Element* Document::find_element(const char* xpath) const
+    {
+        try
+        {
+            return get_root_element()->find_element(xpath);
+        }
+        catch (const NoRootElement &)
+        {
+            throw EmptyDocument();
+        }
+    }
+
+
+    const Element* Document::find_element(std::string_view xpath) const
+    {
+        try
+        {
+            return get_root_element()->find_element(xpath);
+        }
+        catch (const NoRootElement &)
+        {
+            throw EmptyDocument();
+        }
+    }
+
+
     std::vector<Element*> Document::find_elements(const std::string& xpath)
     {
         try
@@ -282,6 +537,32 @@ namespace xml
     }
 
 
+    std::vector<Element*> Document::find_elements(const char* xpath)
+    {
+        try
+        {
+            return get_root_element()->find_elements(xpath);
+        }
+        catch (const NoRootElement &)
+        {
+            throw EmptyDocument();
+        }
+    }
+
+
+    std::vector<Element*> Document::find_elements(std::string_view xpath)
+    {
+        try
+        {
+            return get_root_element()->find_elements(xpath);
+        }
+        catch (const NoRootElement &)
+        {
+            throw EmptyDocument();
+        }
+    }
+
+
     std::vector<const Element*> Document::find_elements(const std::string& xpath) const
     {
         try
@@ -295,11 +576,11 @@ namespace xml
     }
 
 
-    std::string Document::query_string(const std::string& xpath) const
+    std::vector<const Element*> Document::find_elements(const char* xpath) const
     {
         try
         {
-            return get_root_element()->query_string(xpath);
+            return get_root_element()->find_elements(xpath);
         }
         catch (const NoRootElement &)
         {
@@ -308,11 +589,50 @@ namespace xml
     }
 
 
-    double Document::query_number(const std::string& xpath) const
+    std::vector<const Element*> Document::find_elements(std::string_view xpath) const
     {
         try
         {
-            return get_root_element()->query_number(xpath);
+            return get_root_element()->find_elements(xpath);
+        }
+        catch (const NoRootElement &)
+        {
+            throw EmptyDocument();
+        }
+    }
+
+
+    bool Document::exists(const std::string& xpath) const
+    {
+        try
+        {
+            return get_root_element()->exists(xpath);
+        }
+        catch (const NoRootElement &)
+        {
+            throw EmptyDocument();
+        }
+    }
+
+
+    bool Document::exists(const XPath& xpath) const
+    {
+        try
+        {
+            return get_root_element()->exists(xpath);
+        }
+        catch (const NoRootElement &)
+        {
+            throw EmptyDocument();
+        }
+    }
+
+
+    size_t Document::count(const std::string& xpath) const
+    {
+        try
+        {
+            return get_root_element()->count(xpath);
         }
         catch (const NoRootElement &)
         {
@@ -321,6 +641,395 @@ namespace xml
     }
 
 
+    size_t Document::count(const XPath& xpath) const
+    {
+        try
+        {
+            return get_root_element()->count(xpath);
+        }
+        catch (const NoRootElement &)
+        {
+            throw EmptyDocument();
+        }
+    }
+
+
+    std::string Document::query_string(const std::string& xpath) const
+    {
+        try
+        {
+            return get_root_element()->query_string(xpath);
+        }
+        catch (const NoRootElement &)
+        {
+            throw EmptyDocument();
+        }
+    }
+
+
+    double Document::query_number(const std::string& xpath) const
+    {
+        try
+        {
+            return get_root_element()->query_number(xpath);
+        }
+        catch (const NoRootElement &)
+        {
+            throw EmptyDocument();
+        }
+    }
+
+
+    Node* Document::find_node(const XPath& xpath)
+    {
+        try
+        {
+            return get_root_element()->find_node(xpath);
+        }
+        catch (const NoRootElement &)
+        {
+            throw EmptyDocument();
+        }
+    }
+
+
+    const Node* Document::find_node(const XPath& xpath) const
+    {
+        try
+        {
+            return get_root_element()->find_node(xpath);
+        }
+        catch (const NoRootElement &)
+        {
+            throw EmptyDocument();
+        }
+    }
+
+
+    std::vector<Node*> Document::find_nodes(const XPath& xpath)
+    {
+        try
+        {
+            return get_root_element()->find_nodes(xpath);
+        }
+        catch (const NoRootElement &)
+        {
+            throw EmptyDocument();
+        }
+    }
+
+
+    std::vector<const Node*> Document::find_nodes(const XPath& xpath) const
+    {
+        try
+        {
+            return get_root_element()->find_nodes(xpath);
+        }
+        catch (const NoRootElement &)
+        {
+            throw EmptyDocument();
+        }
+    }
+
+
+    Element* Document::find_element(const XPath& xpath)
+    {
+        try
+        {
+            return get_root_element()->find_element(xpath);
+        }
+        catch (const NoRootElement &)
+        {
+            throw EmptyDocument();
+        }
+    }
+
+
+    const Element* Document::find_element(const XPath& xpath) const
+    {
+        try
+        {
+            return get_root_element()->find_element(xpath);
+        }
+        catch (const NoRootElement &)
+        {
+            throw EmptyDocument();
+        }
+    }
+
+
+    std::vector<Element*> Document::find_elements(const XPath& xpath)
+    {
+        try
+        {
+            return get_root_element()->find_elements(xpath);
+        }
+        catch (const NoRootElement &)
+        {
+            throw EmptyDocument();
+        }
+    }
+
+
+    std::vector<const Element*> Document::find_elements(const XPath& xpath) const
+    {
+        try
+        {
+            return get_root_element()->find_elements(xpath);
+        }
+        catch (const NoRootElement &)
+        {
+            throw EmptyDocument();
+        }
+    }
+
+
+    NodeSetView<Node> Document::select_nodes(const std::string& xpath)
+    {
+        try
+        {
+            return get_root_element()->select_nodes(xpath);
+        }
+        catch (const NoRootElement &)
+        {
+            throw EmptyDocument();
+        }
+    }
+
+
+    NodeSetView<const Node> Document::select_nodes(const std::string& xpath) const
+    {
+        try
+        {
+            return get_root_element()->select_nodes(xpath);
+        }
+        catch (const NoRootElement &)
+        {
+            throw EmptyDocument();
+        }
+    }
+
+
+    NodeSetView<Node> Document::select_nodes(const XPath& xpath)
+    {
+        try
+        {
+            return get_root_element()->select_nodes(xpath);
+        }
+        catch (const NoRootElement &)
+        {
+            throw EmptyDocument();
+        }
+    }
+
+
+    NodeSetView<const Node> Document::select_nodes(const XPath& xpath) const
+    {
+        try
+        {
+            return get_root_element()->select_nodes(xpath);
+        }
+        catch (const NoRootElement &)
+        {
+            throw EmptyDocument();
+        }
+    }
+
+
+    NodeSetView<Element> Document::select_elements(const std::string& xpath)
+    {
+        try
+        {
+            return get_root_element()->select_elements(xpath);
+        }
+        catch (const NoRootElement &)
+        {
+            throw EmptyDocument();
+        }
+    }
+
+
+    NodeSetView<const Element> Document::select_elements(const std::string& xpath) const
+    {
+        try
+        {
+            return get_root_element()->select_elements(xpath);
+        }
+        catch (const NoRootElement &)
+        {
+            throw EmptyDocument();
+        }
+    }
+
+
+    NodeSetView<Element> Document::select_elements(const XPath& xpath)
+    {
+        try
+        {
+            return get_root_element()->select_elements(xpath);
+        }
+        catch (const NoRootElement &)
+        {
+            throw EmptyDocument();
+        }
+    }
+
+
+    NodeSetView<const Element> Document::select_elements(const XPath& xpath) const
+    {
+        try
+        {
+            return get_root_element()->select_elements(xpath);
+        }
+        catch (const NoRootElement &)
+        {
+            throw EmptyDocument();
+        }
+    }
+
+
+    std::string Document::query_string(const XPath& xpath) const
+    {
+        try
+        {
+            return get_root_element()->query_string(xpath);
+        }
+        catch (const NoRootElement &)
+        {
+            throw EmptyDocument();
+        }
+    }
+
+
+    double Document::query_number(const XPath& xpath) const
+    {
+        try
+        {
+            return get_root_element()->query_number(xpath);
+        }
+        catch (const NoRootElement &)
+        {
+            throw EmptyDocument();
+        }
+    }
+
+
+    void Document::replace(xmlDoc* tmp_cobj)
+    {
+        if (tmp_cobj == NULL)
+        {
+            throw Exception(get_last_error());
+        }
+        free_xpath_contexts();
+        xmlFreeDoc(cobj);
+        cobj = tmp_cobj;
+        cobj->_private = this;
+    }
+
+
+    void Document::register_namespace(const std::string& prefix, const std::string& uri)
+    {
+        std::lock_guard<std::mutex> lock(get_xpath_mutex());
+        xpath_namespaces.push_back(std::make_pair(prefix, uri));
+        for (size_t i = 0; i < xpath_contexts.size(); i++)
+        {
+            xmlXPathRegisterNs(xpath_contexts[i]->ctxt, reinterpret_cast<const xmlChar*>(prefix.c_str()), reinterpret_cast<const xmlChar*>(uri.c_str()));
+        }
+    }
+
+
+    void Document::register_variable(const std::string& name, const std::string& value)
+    {
+        add_xpath_variable(name, xmlXPathNewString(reinterpret_cast<const xmlChar*>(value.c_str())));
+    }
+
+
+    void Document::register_variable(const std::string& name, double value)
+    {
+        add_xpath_variable(name, xmlXPathNewFloat(value));
+    }
+
+
+    void Document::add_xpath_variable(const std::string& name, xmlXPathObject* value)
+    {
+        std::lock_guard<std::mutex> lock(get_xpath_mutex());
+        xpath_variables.push_back(std::make_pair(name, value));
+        for (size_t i = 0; i < xpath_contexts.size(); i++)
+        {
+            xmlXPathRegisterVariable(xpath_contexts[i]->ctxt, reinterpret_cast<const xmlChar*>(name.c_str()), xmlXPathObjectCopy(value));
+        }
+    }
+
+
+    xmlXPathContext* Document::get_xpath_context() const
+    {
+        for (size_t i = 0; i < xpath_context_cache_size; i++)
+        {
+            if (xpath_context_cache[i].generation == xpath_generation)
+            {
+                return xpath_context_cache[i].ctxt;
+            }
+        }
+
+        std::lock_guard<std::mutex> lock(get_xpath_mutex());
+        if (thread_xpath_contexts_alive)
+        {
+            const std::vector<XPathContextEntry*>& entries = thread_xpath_contexts.entries;
+            for (size_t i = 0; i < entries.size(); i++)
+            {
+                if (entries[i]->generation == xpath_generation)
+                {
+                    remember_xpath_context(xpath_generation, entries[i]->ctxt);
+                    return entries[i]->ctxt;
+                }
+            }
+        }
+
+        xmlXPathContext* ctxt = xmlXPathNewContext(cobj);
+        if (ctxt == NULL)
+        {
+            throw Exception(get_last_error());
+        }
+        for (size_t i = 0; i < xpath_namespaces.size(); i++)
+        {
+            xmlXPathRegisterNs(ctxt, reinterpret_cast<const xmlChar*>(xpath_namespaces[i].first.c_str()), reinterpret_cast<const xmlChar*>(xpath_namespaces[i].second.c_str()));
+        }
+        for (size_t i = 0; i < xpath_variables.size(); i++)
+        {
+            xmlXPathRegisterVariable(ctxt, reinterpret_cast<const xmlChar*>(xpath_variables[i].first.c_str()), xmlXPathObjectCopy(xpath_variables[i].second));
+        }
+
+        // A thread that is shutting down can not track its contexts any
+        // more, those are only freed with the document.
+        XPathContextEntry* entry = new XPathContextEntry{ctxt, xpath_generation, &xpath_contexts, NULL};
+        xpath_contexts.push_back(entry);
+        if (thread_xpath_contexts_alive)
+        {
+            entry->thread = &thread_xpath_contexts;
+            thread_xpath_contexts.entries.push_back(entry);
+            remember_xpath_context(xpath_generation, ctxt);
+        }
+        return ctxt;
+    }
+
+
+    void Document::free_xpath_contexts()
+    {
+        std::lock_guard<std::mutex> lock(get_xpath_mutex());
+        for (size_t i = 0; i < xpath_contexts.size(); i++)
+        {
+            if (xpath_contexts[i]->thread != NULL)
+            {
+                remove_entry(xpath_contexts[i]->thread->entries, xpath_contexts[i]);
+            }
+            xmlXPathFreeContext(xpath_contexts[i]->ctxt);
+            delete xpath_contexts[i];
+        }
+        xpath_contexts.clear();
+        xpath_generation = new_xpath_generation();
+    }
+
+
     LIBXMLMM_EXPORT
     std::ostream& operator << (std::ostream& os, const Document& doc)
     {
@@ -22,15 +22,21 @@
 #pragma once
 
 #include <string>
+#include <string_view>
 #include <iosfwd>
+#include <vector>
 #include <libxml/tree.h>
+#include <libxml/xpath.h>
 
 #include "defines.h"
 #include "LibXmlSentry.h"
+#include "ParseOptions.h"
 #include "Element.h"
 
 namespace xml
 {
+    struct XPathContextEntry;
+
     /**
      * XML DOM Document
      *
@@ -126,21 +132,68 @@ namespace xml
         /**
          * Read document from string.
          *
-         * @todo Add error handling.
+         * @param xml The xml text.
+         * @param options The parser options.
+         *
+         * @exception Exception Throws Exception if the xml is invalid.
+         **/
+        void read_from_string(const std::string& xml, const ParseOptions& options = ParseOptions());
+
+        /**
+         * Read document from a memory buffer.
+         *
+         * The buffer is handed to libxml as is, it does not need to be
+         * null terminated and is neither copied nor scanned for its length.
+         *
+         * @param data The start of the xml data.
+         * @param size The size of the xml data in bytes.
+         * @param options The parser options.
+         *
+         * @exception Exception Throws Exception if the xml is invalid.
+         *
+         * @{
          **/
-        void read_from_string(const std::string& xml);
+        void read_from_buffer(const char* data, size_t size, const ParseOptions& options = ParseOptions());
+        void read_from_buffer(std::string_view xml, const ParseOptions& options = ParseOptions());
+        /** @} **/
 
         /**
          * Read document from stream.
          *
-         * @todo Add error handling.
+         * The stream is read in blocks that are parsed as they arrive.
+         *
+         * @param is The stream to read.
+         * @param options The parser options.
+         *
+         * @exception Exception Throws Exception if the xml is invalid.
          **/
-        void read_from_stream(std::istream& is);
+        void read_from_stream(std::istream& is, const ParseOptions& options = ParseOptions());
 
         /**
          * Read the XML document from file.
+         *
+         * @param file The file to read.
+         * @param options The parser options.
+         *
+         * @exception Exception Throws Exception if the file can not be
+         * read or the xml is invalid.
          **/
-        void read_from_file(const std::string& file);
+        void read_from_file(const std::string& file, const ParseOptions& options = ParseOptions());
+
+        /**
+         * Read the XML document from a memory mapped file.
+         *
+         * The file is mapped into memory and parsed directly from the
+         * mapping, this avoids libxml's buffered file I/O and is faster
+         * on large files.
+         *
+         * @param file The file to read.
+         * @param options The parser options.
+         *
+         * @exception Exception Throws Exception if the file can not be
+         * mapped or the xml is invalid.
+         **/
+        void read_from_file_mapped(const std::string& file, const ParseOptions& options = ParseOptions());
 
         /**
          * Find a given node.
@@ -153,6 +206,12 @@ namespace xml
          **/
         Node* find_node(const std::string& xpath);
         const Node* find_node(const std::string& xpath) const;
+        Node* find_node(const XPath& xpath);
+        const Node* find_node(const XPath& xpath) const;
+        Node* find_node(const char* xpath);
+        const Node* find_node(const char* xpath) const;
+        Node* find_node(std::string_view xpath);
+        const Node* find_node(std::string_view xpath) const;
         /** @} **/
 
         /**
@@ -166,6 +225,12 @@ namespace xml
          **/
         std::vector<Node*> find_nodes(const std::string& xpath);
         std::vector<const Node*> find_nodes(const std::string& xpath) const;
+        std::vector<Node*> find_nodes(const XPath& xpath);
+        std::vector<const Node*> find_nodes(const XPath& xpath) const;
+        std::vector<Node*> find_nodes(const char* xpath);
+        std::vector<const Node*> find_nodes(const char* xpath) const;
+        std::vector<Node*> find_nodes(std::string_view xpath);
+        std::vector<const Node*> find_nodes(std::string_view xpath) const;
         /** @} **/
 
         /**
@@ -179,6 +244,12 @@ namespace xml
          **/
         Element* find_element(const std::string& xpath);
         const Element* find_element(const std::string& xpath) const;
+        Element* find_element(const XPath& xpath);
+        const Element* find_element(const XPath& xpath) const;
+        Element* find_element(const char* xpath);
+        const Element* find_element(const char* xpath) const;
+        Element* find_element(std::string_view xpath);
+        const Element* find_element(std::string_view xpath) const;
         /** @} **/
 
         /**
@@ -192,6 +263,74 @@ namespace xml
          **/
         std::vector<Element*> find_elements(const std::string& xpath);
         std::vector<const Element*> find_elements(const std::string& xpath) const;
+        std::vector<Element*> find_elements(const XPath& xpath);
+        std::vector<const Element*> find_elements(const XPath& xpath) const;
+        std::vector<Element*> find_elements(const char* xpath);
+        std::vector<const Element*> find_elements(const char* xpath) const;
+        std::vector<Element*> find_elements(std::string_view xpath);
+        std::vector<const Element*> find_elements(std::string_view xpath) const;
+        /** @} **/
+
+        /**
+         * Select a set of nodes.
+         *
+         * @param xpath the xpath
+         *
+         * @return a view of the nodes found
+         *
+         * @see Node::select_nodes
+         *
+         * @{
+         **/
+        NodeSetView<Node> select_nodes(const std::string& xpath);
+        NodeSetView<const Node> select_nodes(const std::string& xpath) const;
+        NodeSetView<Node> select_nodes(const XPath& xpath);
+        NodeSetView<const Node> select_nodes(const XPath& xpath) const;
+        /** @} **/
+
+        /**
+         * Select a set of elements.
+         *
+         * @param xpath the xpath relative to this element
+         *
+         * @return a view of the elements found
+         *
+         * @see Node::select_nodes
+         *
+         * @{
+         **/
+        NodeSetView<Element> select_elements(const std::string& xpath);
+        NodeSetView<const Element> select_elements(const std::string& xpath) const;
+        NodeSetView<Element> select_elements(const XPath& xpath);
+        NodeSetView<const Element> select_elements(const XPath& xpath) const;
+        /** @} **/
+
+        /**
+         * Check if a query has a result.
+         *
+         * @param xpath the xpath
+         *
+         * @return true if the query has a result
+         *
+         * @see Node::exists
+         *
+         * @{
+         **/
+        bool exists(const std::string& xpath) const;
+        bool exists(const XPath& xpath) const;
+        /** @} **/
+
+        /**
+         * Count the nodes matching a query.
+         *
+         * @param xpath the xpath
+         *
+         * @return the number of nodes found
+         *
+         * @{
+         **/
+        size_t count(const std::string& xpath) const;
+        size_t count(const XPath& xpath) const;
         /** @} **/
 
         /**
@@ -205,12 +344,79 @@ namespace xml
          **/
         std::string query_string(const std::string& xpath) const;
         double query_number(const std::string& xpath) const;
+        std::string query_string(const XPath& xpath) const;
+        double query_number(const XPath& xpath) const;
+        /** @} **/
+
+        /**
+         * Register a namespace prefix for XPath queries.
+         *
+         * The prefix can be used in all following queries on this document
+         * and on its nodes.
+         *
+         * @param prefix The prefix used in the XPath expressions.
+         * @param uri The namespace URI.
+         **/
+        void register_namespace(const std::string& prefix, const std::string& uri);
+
+        /**
+         * Register a variable for XPath queries.
+         *
+         * The variable can be used as $name in all following queries on
+         * this document and on its nodes.
+         *
+         * @param name The name of the variable.
+         * @param value The value of the variable.
+         *
+         * @{
+         **/
+        void register_variable(const std::string& name, const std::string& value);
+        void register_variable(const std::string& name, double value);
         /** @} **/
 
     private:
+        // Declared first, libxml must be initialized before cobj is created.
+        LibXmlSentry libxml_sentry;
+
         xmlDoc* cobj;
 
-        LibXmlSentry libxml_sentry;
+        /**
+         * Replace the wrapped document with a freshly parsed one.
+         *
+         * @exception Exception Throws Exception if tmp_cobj is NULL.
+         **/
+        void replace(xmlDoc* tmp_cobj);
+
+        /**
+         * XPath contexts, one per thread that queried this document.
+         *
+         * Creating a xmlXPathContext for every query is costly, so each
+         * thread gets its own context on its first query and reuses it.
+         * The registered namespaces and variables are applied to every
+         * context. A context is freed with the document or when its
+         * thread exits, whichever comes first, so only the contexts of
+         * live threads are kept.
+         *
+         * Each thread also remembers the contexts it used last by the
+         * document's generation, so repeated queries do not take the lock.
+         * The generation is unique and changes whenever the contexts are
+         * freed.
+         **/
+        unsigned long long xpath_generation;
+        mutable std::vector<XPathContextEntry*> xpath_contexts;
+        std::vector<std::pair<std::string, std::string> > xpath_namespaces;
+        std::vector<std::pair<std::string, xmlXPathObject*> > xpath_variables;
+
+        /**
+         * Get the calling thread's XPath context.
+         **/
+        xmlXPathContext* get_xpath_context() const;
+
+        void free_xpath_contexts();
+        void add_xpath_variable(const std::string& name, xmlXPathObject* value);
+
+        friend class Parser;
+        friend class Node;
 
         Document(const Document&);
         Document& operator = (const Document&);
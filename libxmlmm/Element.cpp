@@ -47,36 +47,131 @@ namespace xml
 
     void Element::set_name(const std::string& value)
     {
-        xmlNodeSetName(cobj, reinterpret_cast<const xmlChar*>(value.c_str()));
+        set_name(value.c_str());
+    }
+
+
+    void Element::set_name(const char* value)
+    {
+        xmlNodeSetName(cobj, reinterpret_cast<const xmlChar*>(value));
+    }
+
+
+    void Element::set_name(std::string_view value)
+    {
+        const NulTerminated tmp(value);
+        set_name(tmp.c_str());
     }
 
 
     bool Element::has_attribute(const std::string& key) const
     {
-        return xmlGetProp(cobj, reinterpret_cast<const xmlChar*>(key.c_str())) != NULL;
+        return has_attribute(key.c_str());
+    }
+
+
+    bool Element::has_attribute(const char* key) const
+    {
+        return xmlHasProp(cobj, reinterpret_cast<const xmlChar*>(key)) != NULL;
+    }
+
+
+    bool Element::has_attribute(std::string_view key) const
+    {
+        const NulTerminated tmp(key);
+        return has_attribute(tmp.c_str());
     }
 
 
     std::string Element::get_attribute(const std::string& key) const
     {
-        const xmlChar* const value = xmlGetProp(cobj, reinterpret_cast<const xmlChar*>(key.c_str()));
-        if (!value)
+        return get_attribute(key.c_str());
+    }
+
+
+    std::string Element::get_attribute(const char* key) const
+    {
+        const xmlAttr* const attr = xmlHasProp(cobj, reinterpret_cast<const xmlChar*>(key));
+        if (attr == NULL)
+        {
+            throw NoSuchAttribute(key, get_name());
+        }
+        return get_attribute_value(attr);
+    }
+
+
+    std::string Element::get_attribute(std::string_view key) const
+    {
+        const NulTerminated tmp(key);
+        return get_attribute(tmp.c_str());
+    }
+
+
+    std::string_view Element::get_attribute_view(const std::string& key) const
+    {
+        return get_attribute_view(key.c_str());
+    }
+
+
+    std::string_view Element::get_attribute_view(const char* key) const
+    {
+        const xmlAttr* const attr = xmlHasProp(cobj, reinterpret_cast<const xmlChar*>(key));
+        if (attr == NULL)
         {
             throw NoSuchAttribute(key, get_name());
         }
-        return reinterpret_cast<const char*>(value);
+        std::string_view value;
+        if (!xml::get_attribute_view(attr, value))
+        {
+            throw Exception("The value of attribute " + std::string(key) + " is not stored as one string.");
+        }
+        return value;
+    }
+
+
+    std::string_view Element::get_attribute_view(std::string_view key) const
+    {
+        const NulTerminated tmp(key);
+        return get_attribute_view(tmp.c_str());
     }
 
 
     void Element::set_attribute(const std::string& key, const std::string& value)
     {
-        xmlSetProp(cobj, reinterpret_cast<const xmlChar*>(key.c_str()), reinterpret_cast<const xmlChar*>(value.c_str()));
+        set_attribute(key.c_str(), value.c_str());
+    }
+
+
+    void Element::set_attribute(const char* key, const char* value)
+    {
+        xmlSetProp(cobj, reinterpret_cast<const xmlChar*>(key), reinterpret_cast<const xmlChar*>(value));
+    }
+
+
+    void Element::set_attribute(std::string_view key, std::string_view value)
+    {
+        const NulTerminated tmp_key(key);
+        const NulTerminated tmp_value(value);
+        set_attribute(tmp_key.c_str(), tmp_value.c_str());
     }
 
 
     void Element::remove_attribute(const std::string& key)
     {
-        xmlUnsetProp(cobj, reinterpret_cast<const xmlChar*>(key.c_str()));
+        remove_attribute(key.c_str());
+    }
+
+
+    void Element::remove_attribute(const char* key)
+    {
+        xmlUnsetProp(cobj, reinterpret_cast<const xmlChar*>(key));
+    }
+
+
+    void Element::remove_attribute(std::string_view key)
+    {
+        const NulTerminated tmp(key);
+        remove_attribute(tmp.c_str());
     }
 
 
@@ -103,11 +198,11 @@ namespace xml
         {
             if (child->type == XML_TEXT_NODE)
             {
-                return reinterpret_cast<Content*>(child->_private);
+                return static_cast<Content*>(get_wrapper(child));
             }
             if (child->type == XML_CDATA_SECTION_NODE)
             {
-                return reinterpret_cast<Content*>(child->_private);
+                return static_cast<Content*>(get_wrapper(child));
             }
         }
         return NULL;
@@ -137,9 +232,22 @@ namespace xml
 
     Element* Element::add_element(const std::string& name)
     {
-        xmlNode* node = xmlNewNode(NULL, reinterpret_cast<const xmlChar*>(name.c_str()));
+        return add_element(name.c_str());
+    }
+
+
+    Element* Element::add_element(const char* name)
+    {
+        xmlNode* node = xmlNewNode(NULL, reinterpret_cast<const xmlChar*>(name));
         xmlAddChild(cobj, node);
-        return reinterpret_cast<Element*>(node->_private);
+        return static_cast<Element*>(get_wrapper(node));
+    }
+
+
+    Element* Element::add_element(std::string_view name)
+    {
+        const NulTerminated tmp(name);
+        return add_element(tmp.c_str());
     }
 
 
@@ -149,7 +257,7 @@ namespace xml
         xmlNode* child = cobj->children;
         while (child != NULL)
         {
-            children.push_back(reinterpret_cast<Node*>(child->_private));
+            children.push_back(get_wrapper(child));
             child = child->next;
         }
         return children;
@@ -159,36 +267,190 @@ namespace xml
     std::vector<const Node*> Element::get_children() const
     {
         std::vector<const Node*> children;
-        const xmlNode* child = cobj->children;
+        xmlNode* child = cobj->children;
         while (child != NULL)
         {
-            children.push_back(reinterpret_cast<const Node*>(child->_private));
+            children.push_back(get_wrapper(child));
             child = child->next;
         }
         return children;
     }
 
 
+    NodeRange<Node> Element::children()
+    {
+        return NodeRange<Node>(cobj->children);
+    }
+
+
+    NodeRange<const Node> Element::children() const
+    {
+        return NodeRange<const Node>(cobj->children);
+    }
+
+
+    ElementRange<Element> Element::child_elements()
+    {
+        return ElementRange<Element>(cobj->children);
+    }
+
+
+    ElementRange<const Element> Element::child_elements() const
+    {
+        return ElementRange<const Element>(cobj->children);
+    }
+
+
+    ElementRange<Element> Element::child_elements(const char* name)
+    {
+        return ElementRange<Element>(cobj->children, name);
+    }
+
+
+    ElementRange<const Element> Element::child_elements(const char* name) const
+    {
+        return ElementRange<const Element>(cobj->children, name);
+    }
+
+
+    ElementRange<Element> Element::child_elements(std::string_view name)
+    {
+        return ElementRange<Element>(cobj->children, name);
+    }
+
+
+    ElementRange<const Element> Element::child_elements(std::string_view name) const
+    {
+        return ElementRange<const Element>(cobj->children, name);
+    }
+
+
+    AttributeRange Element::attributes() const
+    {
+        return AttributeRange(cobj->properties);
+    }
+
+
     Element* Element::find_element(const std::string& xpath)
     {
         return this->find<Element*>(xpath);
     }
 
 
+    Element* Element::find_element(const char* xpath)
+    {
+        return this->find<Element*>(xpath);
+    }
+
+
+    Element* Element::find_element(std::string_view xpath)
+    {
+        const NulTerminated tmp(xpath);
+        return this->find<Element*>(tmp.c_str());
+    }
+
+
     const Element* Element::find_element(const std::string& xpath) const
     {
         return this->find<const Element*>(xpath);
     }
 
 
+    const Element* Element::find_element(const char* xpath) const
+    {
+        return this->find<const Element*>(xpath);
+    }
+
+
+    const Element* Element::find_element(std::string_view xpath) const
+    {
+        const NulTerminated tmp(xpath);
+        return this->find<const Element*>(tmp.c_str());
+    }
+
+
     std::vector<Element*> Element::find_elements(const std::string& xpath)
     {
         return this->find_all<Element*>(xpath);
     }
 
 
+    std::vector<Element*> Element::find_elements(const char* xpath)
+    {
+        return this->find_all<Element*>(xpath);
+    }
+
+
+    std::vector<Element*> Element::find_elements(std::string_view xpath)
+    {
+        const NulTerminated tmp(xpath);
+        return this->find_all<Element*>(tmp.c_str());
+    }
+
+
     std::vector<const Element*> Element::find_elements(const std::string& xpath) const
     {
         return this->find_all<const Element*>(xpath);
     }
+
+
+    std::vector<const Element*> Element::find_elements(const char* xpath) const
+    {
+        return this->find_all<const Element*>(xpath);
+    }
+
+
+    std::vector<const Element*> Element::find_elements(std::string_view xpath) const
+    {
+        const NulTerminated tmp(xpath);
+        return this->find_all<const Element*>(tmp.c_str());
+    }
+
+
+    Element* Element::find_element(const XPath& xpath)
+    {
+        return this->find<Element*>(xpath);
+    }
+
+
+    const Element* Element::find_element(const XPath& xpath) const
+    {
+        return this->find<const Element*>(xpath);
+    }
+
+
+    std::vector<Element*> Element::find_elements(const XPath& xpath)
+    {
+        return this->find_all<Element*>(xpath);
+    }
+
+
+    std::vector<const Element*> Element::find_elements(const XPath& xpath) const
+    {
+        return this->find_all<const Element*>(xpath);
+    }
+
+
+    NodeSetView<Element> Element::select_elements(const std::string& xpath)
+    {
+        return this->select<Element>(xpath);
+    }
+
+
+    NodeSetView<const Element> Element::select_elements(const std::string& xpath) const
+    {
+        return this->select<const Element>(xpath);
+    }
+
+
+    NodeSetView<Element> Element::select_elements(const XPath& xpath)
+    {
+        return this->select<Element>(xpath);
+    }
+
+
+    NodeSetView<const Element> Element::select_elements(const XPath& xpath) const
+    {
+        return this->select<const Element>(xpath);
+    }
 }
@@ -22,10 +22,14 @@
 #pragma once
 
 #include <string>
+#include <string_view>
 #include <sstream>
 
 #include "Node.h"
 #include "Text.h"
+#include "NodeRange.h"
+#include "ElementRange.h"
+#include "AttributeRange.h"
 #include "exceptions.h"
 
 namespace xml
@@ -48,13 +52,23 @@ namespace xml
 
         /**
          * Set a node's name.
+         *
+         * @{
          **/
         void set_name(const std::string& value);
+        void set_name(const char* value);
+        void set_name(std::string_view value);
+        /** @} **/
 
         /**
          * Check if a given attribute exists.
+         *
+         * @{
          **/
         bool has_attribute(const std::string& key) const;
+        bool has_attribute(const char* key) const;
+        bool has_attribute(std::string_view key) const;
+        /** @} **/
 
         /**
          * Get a given attribute.
@@ -66,58 +80,117 @@ namespace xml
          *
          * @throws no_such_attribute if the attibute does not exist on
          * this element.
+         *
+         * @{
          **/
         std::string get_attribute(const std::string& key) const;
+        std::string get_attribute(const char* key) const;
+        std::string get_attribute(std::string_view key) const;
+        /** @} **/
+
+        /**
+         * Get a given attribute without copying it.
+         *
+         * The returned view points into the document; it is valid until
+         * the attribute is changed or removed.
+         *
+         * @param key the attribute name
+         * @return the attribute value
+         *
+         * @throws NoSuchAttribute if the attribute does not exist on
+         * this element.
+         * @throws Exception if the value is not stored as one string in
+         * the document, which happens for values with entity references
+         * that were not substituted.
+         *
+         * @{
+         **/
+        std::string_view get_attribute_view(const std::string& key) const;
+        std::string_view get_attribute_view(const char* key) const;
+        std::string_view get_attribute_view(std::string_view key) const;
+        /** @} **/
 
         /**
          * Get a given attribute in given type.
          *
          * This method will retrive an attribute and try to convert it
-         * to the given type with the help of stream operators.
+         * to the given type. Numbers are converted with std::from_chars,
+         * other types with the help of stream operators.
          *
          * @param id the attribtue id
          * @return the attribute value
          *
          * @throws no_such_attribute if the attibute does not exist on
          * this element.
+         * @throws Exception if the value can not be converted.
          *
-         * @todo add check if conversion to value worked
+         * @{
          **/
         template <typename T>
         T get_attribute(const std::string& id) const
         {
-            std::stringstream conv(get_attribute(id));
+            return convert_attribute<T>(get_attribute(id));
+        }
 
-            T value;
-            conv >> value;
-            if (! conv.eof())
-            {
-                throw xml::Exception("xml::Element::get_attribute<>: Type conversion failed.");
-            }
+        template <typename T>
+        T get_attribute(const char* id) const
+        {
+            return convert_attribute<T>(get_attribute(id));
+        }
 
-            return value;
+        template <typename T>
+        T get_attribute(std::string_view id) const
+        {
+            return convert_attribute<T>(get_attribute(id));
         }
+        /** @} **/
 
         /**
          * Set an attribute.
+         *
+         * @{
          **/
         void set_attribute(const std::string& id, const std::string& value);
+        void set_attribute(const char* id, const char* value);
+        void set_attribute(std::string_view id, std::string_view value);
+        /** @} **/
 
         /**
          * Set an attribute with generic type.
+         *
+         * Numbers are converted with std::to_chars, other types with the
+         * help of stream operators.
+         *
+         * @{
          **/
-        template <typename T>
+        template <typename T, typename = typename std::enable_if<!std::is_convertible<T, std::string_view>::value>::type>
         void set_attribute(const std::string& id, T value)
         {
-            std::stringstream conv;
-            conv << value;
-            set_attribute(id, conv.str());
+            set_attribute(id, xml::to_string(value));
         }
 
+        template <typename T, typename = typename std::enable_if<!std::is_convertible<T, std::string_view>::value>::type>
+        void set_attribute(const char* id, T value)
+        {
+            set_attribute(id, xml::to_string(value).c_str());
+        }
+
+        template <typename T, typename = typename std::enable_if<!std::is_convertible<T, std::string_view>::value>::type>
+        void set_attribute(std::string_view id, T value)
+        {
+            set_attribute(id, std::string_view(xml::to_string(value)));
+        }
+        /** @} **/
+
         /**
          * Remove a given attribute.
+         *
+         * @{
          **/
         void remove_attribute(const std::string& key);
+        void remove_attribute(const char* key);
+        void remove_attribute(std::string_view key);
+        /** @} **/
 
         /**
          * Get the value of this node.  Empty if not found.
@@ -150,8 +223,13 @@ namespace xml
 
         /**
          * Add a element.
+         *
+         * @{
          **/
         Element* add_element(const std::string& name);
+        Element* add_element(const char* name);
+        Element* add_element(std::string_view name);
+        /** @} **/
 
         /**
          * Get all children of this element.
@@ -167,6 +245,43 @@ namespace xml
          **/
         std::vector<const Node*> get_children() const;
 
+        /**
+         * Iterate the children of this element.
+         *
+         * Unlike get_children, the children are visited in place and no
+         * vector is built.
+         *
+         * @{
+         **/
+        NodeRange<Node> children();
+        NodeRange<const Node> children() const;
+        /** @} **/
+
+        /**
+         * Iterate the child elements of this element.
+         *
+         * @param name only visit elements with this name
+         *
+         * @note The range references the name, so it can not be a
+         * temporary string.
+         *
+         * @{
+         **/
+        ElementRange<Element> child_elements();
+        ElementRange<const Element> child_elements() const;
+        ElementRange<Element> child_elements(const char* name);
+        ElementRange<const Element> child_elements(const char* name) const;
+        ElementRange<Element> child_elements(std::string_view name);
+        ElementRange<const Element> child_elements(std::string_view name) const;
+        ElementRange<Element> child_elements(std::string&& name) = delete;
+        ElementRange<const Element> child_elements(std::string&& name) const = delete;
+        /** @} **/
+
+        /**
+         * Iterate the attributes of this element.
+         **/
+        AttributeRange attributes() const;
+
         /**
          * Find a given element.
          *
@@ -177,6 +292,12 @@ namespace xml
          **/
         Element* find_element(const std::string& xpath);
         const Element* find_element(const std::string& xpath) const;
+        Element* find_element(const XPath& xpath);
+        const Element* find_element(const XPath& xpath) const;
+        Element* find_element(const char* xpath);
+        const Element* find_element(const char* xpath) const;
+        Element* find_element(std::string_view xpath);
+        const Element* find_element(std::string_view xpath) const;
         /** @} **/
 
         /**
@@ -189,9 +310,41 @@ namespace xml
          **/
         std::vector<Element*> find_elements(const std::string& xpath);
         std::vector<const Element*> find_elements(const std::string& xpath) const;
+        std::vector<Element*> find_elements(const XPath& xpath);
+        std::vector<const Element*> find_elements(const XPath& xpath) const;
+        std::vector<Element*> find_elements(const char* xpath);
+        std::vector<const Element*> find_elements(const char* xpath) const;
+        std::vector<Element*> find_elements(std::string_view xpath);
+        std::vector<const Element*> find_elements(std::string_view xpath) const;
         /** @} **/
 
-    private:
+        /**
+         * Select a set of elements.
+         *
+         * @param xpath the XPath relative to this node
+         *
+         * @return a view of the elements found
+         *
+         * @see Node::select_nodes
+         *
+         * @{
+         **/
+        NodeSetView<Element> select_elements(const std::string& xpath);
+        NodeSetView<const Element> select_elements(const std::string& xpath) const;
+        NodeSetView<Element> select_elements(const XPath& xpath);
+        NodeSetView<const Element> select_elements(const XPath& xpath) const;
+        /** @} **/
 
+    private:
+        template <typename T>
+        static T convert_attribute(const std::string& text)
+        {
+            T value = T();
+            if (!parse_value(text, value))
+            {
+                throw xml::Exception("xml::Element::get_attribute<>: Type conversion failed.");
+            }
+            return value;
+        }
     };
 }
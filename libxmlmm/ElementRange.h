@@ -0,0 +1,161 @@
+//
+// Copyright (c) 2008-2020 Sean Farrell
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of
+// this software and associated documentation files (the "Software"), to deal in
+// the Software without restriction, including without limitation the rights to use,
+// copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the
+// Software, and to permit persons to whom the Software is furnished to do so,
+// subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+// INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+// PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+// HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+// OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+// SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+
+#pragma once
+
+#include <iterator>
+#include <string_view>
+#include <libxml/tree.h>
+
+#include "defines.h"
+#include "utils.h"
+
+namespace xml
+{
+    /**
+     * Range over the Child Elements of an Element
+     *
+     * Like NodeRange, but only elements are visited, optionally only
+     * the ones with a given name. Text, comments and other nodes are
+     * skipped while walking the sibling links; nothing is allocated.
+     *
+     * @code
+     * for (xml::Element* row : table->child_elements("row"))
+     * {
+     *     ...
+     * }
+     * @endcode
+     *
+     * @note The range only references the name it filters on; the name
+     * must outlive the range.
+     **/
+    template <typename ElementType>
+    class ElementRange
+    {
+    public:
+        /**
+         * Iterator over the elements of the range.
+         **/
+        class iterator
+        {
+        public:
+            typedef std::forward_iterator_tag iterator_category;
+            typedef ElementType* value_type;
+            typedef std::ptrdiff_t difference_type;
+            typedef ElementType** pointer;
+            typedef ElementType* reference;
+
+            iterator()
+            : node(NULL) {}
+
+            iterator(xmlNode* node, std::string_view name)
+            : node(node), name(name)
+            {
+                skip();
+            }
+
+            ElementType* operator * () const
+            {
+                return static_cast<ElementType*>(get_wrapper(node));
+            }
+
+            iterator& operator ++ ()
+            {
+                node = node->next;
+                skip();
+                return *this;
+            }
+
+            iterator operator ++ (int)
+            {
+                iterator tmp(*this);
+                ++(*this);
+                return tmp;
+            }
+
+            bool operator == (const iterator& other) const
+            {
+                return node == other.node;
+            }
+
+            bool operator != (const iterator& other) const
+            {
+                return node != other.node;
+            }
+
+        private:
+            xmlNode*         node;
+            std::string_view name;
+
+            // Advance to the next matching element, a NULL name matches all.
+            void skip()
+            {
+                while (node != NULL)
+                {
+                    if (node->type == XML_ELEMENT_NODE &&
+                        (name.data() == NULL || reinterpret_cast<const char*>(node->name) == name))
+                    {
+                        return;
+                    }
+                    node = node->next;
+                }
+            }
+        };
+
+        /**
+         * Create a range starting at the given node.
+         *
+         * @param first The first node of a sibling list, may be NULL.
+         * @param name The name of the elements to visit, a view with NULL
+         * data visits all elements.
+         **/
+        explicit ElementRange(xmlNode* first, std::string_view name = std::string_view())
+        : first(first), name(name) {}
+
+        /**
+         * Check if the range is empty.
+         **/
+        bool empty() const
+        {
+            return begin() == end();
+        }
+
+        /**
+         * Get an iterator to the first element.
+         **/
+        iterator begin() const
+        {
+            return iterator(first, name);
+        }
+
+        /**
+         * Get an iterator past the last element.
+         **/
+        iterator end() const
+        {
+            return iterator();
+        }
+
+    private:
+        xmlNode*         first;
+        std::string_view name;
+    };
+}
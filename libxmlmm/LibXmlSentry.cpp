@@ -25,35 +25,112 @@
 
 #include "LibXmlSentry.h"
 
+#include <mutex>
 #include <libxml/tree.h>
 
 #include "utils.h"
 
 namespace xml
 {
-    unsigned int LibXmlSentry::use_count = 0;
+    std::atomic<unsigned int> LibXmlSentry::use_count(0);
+    std::atomic<bool> LibXmlSentry::pinned(false);
 
+    // Only changed with the init mutex held, but read without it.
+    static std::atomic<bool> initialized(false);
+    // Guarded by the init mutex.
+    static unsigned int pin_count = 0;
 
-    LibXmlSentry::LibXmlSentry()
+    // Serializes the initialisation and cleanup of libxml. It is leaked,
+    // so that sentries in static objects can still use it at exit.
+    static std::mutex& get_init_mutex()
+    {
+        static std::mutex* mutex = new std::mutex();
+        return *mutex;
+    }
+
+    static void initialize()
     {
-        if (use_count == 0)
+        if (!initialized)
         {
             xmlInitParser();
             xmlRegisterNodeDefault(wrap_node);
             xmlDeregisterNodeDefault(free_wrapper);
             xmlThrDefRegisterNodeDefault(wrap_node);
             xmlThrDefDeregisterNodeDefault(free_wrapper);
+            initialized = true;
+        }
+    }
+
+
+    LibXmlSentry::LibXmlSentry()
+    : counted(false)
+    {
+        if (pinned.load(std::memory_order_acquire))
+        {
+            return;
         }
+
+        // The count is raised before initialized is checked, so that a
+        // Library guard that cleans up at the same time either sees this
+        // sentry or this sentry sees that libxml must be set up again.
+        counted = true;
         use_count++;
+        if (!initialized)
+        {
+            std::lock_guard<std::mutex> lock(get_init_mutex());
+            initialize();
+        }
     }
 
 
     LibXmlSentry::~LibXmlSentry()
     {
-        use_count--;
-        if (use_count == 0)
+        // libxml is not cleaned up here, other threads that used it may
+        // still be running; see Library.
+        if (counted)
         {
-            xmlCleanupParser();
+            use_count--;
         }
     }
+
+
+    void LibXmlSentry::pin()
+    {
+        std::lock_guard<std::mutex> lock(get_init_mutex());
+        initialize();
+        if (pin_count++ == 0)
+        {
+            pinned.store(true, std::memory_order_release);
+        }
+    }
+
+
+    void LibXmlSentry::unpin()
+    {
+        std::lock_guard<std::mutex> lock(get_init_mutex());
+        if (--pin_count == 0)
+        {
+            pinned.store(false, std::memory_order_release);
+
+            // Clear the flag before looking at the count, a sentry created
+            // meanwhile then either is counted or waits for the lock.
+            if (initialized.exchange(false))
+            {
+                if (use_count == 0)
+                {
+                    xmlCleanupParser();
+                }
+                else
+                {
+                    initialized = true;
+                }
+            }
+        }
+    }
+
+
+    bool LibXmlSentry::is_pinned()
+    {
+        return pinned.load(std::memory_order_acquire);
+    }
 }
@@ -21,6 +21,8 @@
 
 #pragma once
 
+#include <atomic>
+
 namespace xml
 {
     /**
@@ -31,6 +33,15 @@ namespace xml
      *
      * @note Multiple instances of LibXmlSentry can live side by side, libxml
      * will only be initialized once.
+     *
+     * @note Sentries may be created and destroyed concurrently on any
+     * thread. libxml is initialized before the first sentry's constructor
+     * returns. Sentries never clean libxml up, since xmlCleanupParser is
+     * not safe while other threads that used libxml are alive; that is
+     * left to the last Library guard or to process exit.
+     *
+     * @note While libxml is pinned by a Library guard, sentries do no
+     * bookkeeping at all.
      **/
     class LibXmlSentry
     {
@@ -42,13 +53,35 @@ namespace xml
         LibXmlSentry();
 
         /**
-         * Clean up libxml.
+         * Release the sentry, libxml stays initialized.
          **/
         ~LibXmlSentry();
 
+        /**
+         * Keep libxml initialized until unpin is called.
+         **/
+        static void pin();
+
+        /**
+         * Release a pin and clean up libxml when the last pin is released
+         * and no sentry is alive.
+         **/
+        static void unpin();
+
+        /**
+         * Check if libxml is pinned.
+         **/
+        static bool is_pinned();
+
     private:
-        /** The number of instances of libxml. **/
-        static unsigned int use_count;
+        /** The number of counted sentries alive. **/
+        static std::atomic<unsigned int> use_count;
+
+        /** Set while libxml is pinned. **/
+        static std::atomic<bool> pinned;
+
+        /** Whether this sentry holds a reference in use_count. **/
+        bool counted;
 
         LibXmlSentry(const LibXmlSentry&);
         LibXmlSentry& operator = (const LibXmlSentry&);
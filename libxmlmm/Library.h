@@ -0,0 +1,74 @@
+//
+// Copyright (c) 2008-2020 Sean Farrell
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of
+// this software and associated documentation files (the "Software"), to deal in
+// the Software without restriction, including without limitation the rights to use,
+// copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the
+// Software, and to permit persons to whom the Software is furnished to do so,
+// subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+// INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+// PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+// HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+// OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+// SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+
+#pragma once
+
+#include "defines.h"
+
+namespace xml
+{
+    /**
+     * Keeps libxml initialized and cleans it up.
+     *
+     * libxml is initialized when the first libxmlmm object is created and
+     * then stays initialized; its global state is not released before the
+     * process exits, since xmlCleanupParser is not safe while other threads
+     * that used libxml are still alive. While a Library guard is alive,
+     * documents, parsers and readers also skip their bookkeeping entirely,
+     * and the last guard cleans up libxml.
+     *
+     * @code
+     * int main()
+     * {
+     *     xml::Library library;
+     *     ...
+     * }
+     * @endcode
+     *
+     * @note All libxmlmm objects created while the guard is alive must be
+     * destroyed before the guard, and no other thread may use libxml when
+     * the last guard is destroyed. If libxmlmm objects created outside of
+     * a guard are still alive, libxml is not cleaned up. Guards may be
+     * nested.
+     **/
+    class LIBXMLMM_EXPORT Library
+    {
+    public:
+        /**
+         * Initialize libxml and keep it initialized.
+         **/
+        Library();
+
+        /**
+         * Release libxml.
+         **/
+        ~Library();
+
+        /**
+         * Check if a Library guard is alive.
+         **/
+        static bool is_pinned();
+
+    private:
+        Library(const Library&);
+        Library& operator = (const Library&);
+    };
+}
@@ -0,0 +1,151 @@
+//
+// Copyright (c) 2008-2020 Sean Farrell
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of
+// this software and associated documentation files (the "Software"), to deal in
+// the Software without restriction, including without limitation the rights to use,
+// copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the
+// Software, and to permit persons to whom the Software is furnished to do so,
+// subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+// INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+// PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+// HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+// OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+// SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+
+#include "MappedFile.h"
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+#include "exceptions.h"
+
+namespace xml
+{
+#ifdef _WIN32
+
+    MappedFile::MappedFile(const std::string& file)
+    : data(NULL), size(0), file_handle(INVALID_HANDLE_VALUE), mapping_handle(NULL)
+    {
+        file_handle = CreateFileA(file.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, NULL);
+        if (file_handle == INVALID_HANDLE_VALUE)
+        {
+            throw Exception("xml::MappedFile: failed to open '" + file + "'");
+        }
+
+        LARGE_INTEGER file_size;
+        if (!GetFileSizeEx(file_handle, &file_size))
+        {
+            CloseHandle(file_handle);
+            throw Exception("xml::MappedFile: failed to stat '" + file + "'");
+        }
+        size = static_cast<size_t>(file_size.QuadPart);
+
+        // An empty file can not be mapped, but it is a valid (empty) input.
+        if (size == 0)
+        {
+            return;
+        }
+
+        mapping_handle = CreateFileMappingA(file_handle, NULL, PAGE_READONLY, 0, 0, NULL);
+        if (mapping_handle == NULL)
+        {
+            CloseHandle(file_handle);
+            throw Exception("xml::MappedFile: failed to map '" + file + "'");
+        }
+
+        data = reinterpret_cast<const char*>(MapViewOfFile(mapping_handle, FILE_MAP_READ, 0, 0, 0));
+        if (data == NULL)
+        {
+            CloseHandle(mapping_handle);
+            CloseHandle(file_handle);
+            throw Exception("xml::MappedFile: failed to map '" + file + "'");
+        }
+    }
+
+
+    MappedFile::~MappedFile()
+    {
+        if (data != NULL)
+        {
+            UnmapViewOfFile(data);
+        }
+        if (mapping_handle != NULL)
+        {
+            CloseHandle(mapping_handle);
+        }
+        CloseHandle(file_handle);
+    }
+
+#else
+
+    MappedFile::MappedFile(const std::string& file)
+    : data(NULL), size(0)
+    {
+        int fd = open(file.c_str(), O_RDONLY);
+        if (fd == -1)
+        {
+            throw Exception("xml::MappedFile: failed to open '" + file + "'");
+        }
+
+        struct stat info;
+        if (fstat(fd, &info) == -1)
+        {
+            close(fd);
+            throw Exception("xml::MappedFile: failed to stat '" + file + "'");
+        }
+        size = static_cast<size_t>(info.st_size);
+
+        // An empty file can not be mapped, but it is a valid (empty) input.
+        if (size != 0)
+        {
+            void* ptr = mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (ptr == MAP_FAILED)
+            {
+                close(fd);
+                throw Exception("xml::MappedFile: failed to map '" + file + "'");
+            }
+            // The parser consumes the input front to back exactly once.
+            madvise(ptr, size, MADV_SEQUENTIAL);
+            data = reinterpret_cast<const char*>(ptr);
+        }
+
+        // The mapping stays valid after the descriptor is closed.
+        close(fd);
+    }
+
+
+    MappedFile::~MappedFile()
+    {
+        if (data != NULL)
+        {
+            munmap(const_cast<char*>(data), size);
+        }
+    }
+
+#endif
+
+
+    const char* MappedFile::get_data() const
+    {
+        return data;
+    }
+
+
+    size_t MappedFile::get_size() const
+    {
+        return size;
+    }
+}
@@ -0,0 +1,77 @@
+//
+// Copyright (c) 2008-2020 Sean Farrell
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of
+// this software and associated documentation files (the "Software"), to deal in
+// the Software without restriction, including without limitation the rights to use,
+// copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the
+// Software, and to permit persons to whom the Software is furnished to do so,
+// subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+// INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+// PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+// HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+// OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+// SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+
+#pragma once
+
+#include <string>
+#include <cstddef>
+
+namespace xml
+{
+    /**
+     * Read-only memory mapping of a file.
+     *
+     * @note This class is an internal helper class that maps a whole file
+     * into memory so that it can be parsed without going through libxml's
+     * buffered file I/O.
+     **/
+    class MappedFile
+    {
+    public:
+        /**
+         * Map the given file.
+         *
+         * @param file The path of the file to map.
+         *
+         * @exception Exception Throws Exception if the file could not be
+         * opened or mapped.
+         **/
+        explicit MappedFile(const std::string& file);
+
+        /**
+         * Unmap the file.
+         **/
+        ~MappedFile();
+
+        /**
+         * Get the mapped data.
+         *
+         * @return The start of the mapping, NULL if the file is empty.
+         **/
+        const char* get_data() const;
+
+        /**
+         * Get the size of the mapped data.
+         **/
+        size_t get_size() const;
+
+    private:
+        const char* data;
+        size_t size;
+#ifdef _WIN32
+        void* file_handle;
+        void* mapping_handle;
+#endif
+
+        MappedFile(const MappedFile&);
+        MappedFile& operator = (const MappedFile&);
+    };
+}
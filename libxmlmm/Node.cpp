@@ -27,6 +27,10 @@
 #include "exceptions.h"
 #include "Element.h"
 #include "Content.h"
+#include "NodePool.h"
+#include "Document.h"
+#include "XPathCache.h"
+#include "SimplePath.h"
 
 namespace xml
 {
@@ -44,6 +48,18 @@ namespace xml
     }
 
 
+    void* Node::operator new(size_t size)
+    {
+        return NodePool::allocate(size);
+    }
+
+
+    void Node::operator delete(void* ptr, size_t size)
+    {
+        NodePool::release(ptr, size);
+    }
+
+
     std::string Node::get_path() const
     {
         xmlChar* path = xmlGetNodePath(cobj);
@@ -62,7 +78,7 @@ namespace xml
     {
         if (cobj->parent != NULL)
         {
-            return reinterpret_cast<Element*>(cobj->parent->_private);
+            return static_cast<Element*>(get_wrapper(cobj->parent));
         }
         else
         {
@@ -86,29 +102,182 @@ namespace xml
     }
 
 
+    Node* Node::find_node(const char* xpath)
+    {
+        return this->find<Node*>(xpath);
+    }
+
+
+    Node* Node::find_node(std::string_view xpath)
+    {
+        const NulTerminated tmp(xpath);
+        return this->find<Node*>(tmp.c_str());
+    }
+
+
     const Node* Node::find_node(const std::string& xpath) const
     {
         return this->find<const Node*>(xpath);
     }
 
 
+    const Node* Node::find_node(const char* xpath) const
+    {
+        return this->find<const Node*>(xpath);
+    }
+
+
+    const Node* Node::find_node(std::string_view xpath) const
+    {
+        const NulTerminated tmp(xpath);
+        return this->find<const Node*>(tmp.c_str());
+    }
+
+
     std::vector<Node*> Node::find_nodes(const std::string& xpath)
     {
         return this->find_all<Node*>(xpath);
     }
 
 
+    std::vector<Node*> Node::find_nodes(const char* xpath)
+    {
+        return this->find_all<Node*>(xpath);
+    }
+
+
+    std::vector<Node*> Node::find_nodes(std::string_view xpath)
+    {
+        const NulTerminated tmp(xpath);
+        return this->find_all<Node*>(tmp.c_str());
+    }
+
+
     std::vector<const Node*> Node::find_nodes(const std::string& xpath) const
     {
         return this->find_all<const Node*>(xpath);
     }
 
 
+    std::vector<const Node*> Node::find_nodes(const char* xpath) const
+    {
+        return this->find_all<const Node*>(xpath);
+    }
+
+
+    std::vector<const Node*> Node::find_nodes(std::string_view xpath) const
+    {
+        const NulTerminated tmp(xpath);
+        return this->find_all<const Node*>(tmp.c_str());
+    }
+
+
+    Node* Node::find_node(const XPath& xpath)
+    {
+        return this->find<Node*>(xpath);
+    }
+
+
+    const Node* Node::find_node(const XPath& xpath) const
+    {
+        return this->find<const Node*>(xpath);
+    }
+
+
+    std::vector<Node*> Node::find_nodes(const XPath& xpath)
+    {
+        return this->find_all<Node*>(xpath);
+    }
+
+
+    std::vector<const Node*> Node::find_nodes(const XPath& xpath) const
+    {
+        return this->find_all<const Node*>(xpath);
+    }
+
+
+    NodeSetView<Node> Node::select_nodes(const std::string& xpath)
+    {
+        return this->select<Node>(xpath);
+    }
+
+
+    NodeSetView<const Node> Node::select_nodes(const std::string& xpath) const
+    {
+        return this->select<const Node>(xpath);
+    }
+
+
+    NodeSetView<Node> Node::select_nodes(const XPath& xpath)
+    {
+        return this->select<Node>(xpath);
+    }
+
+
+    NodeSetView<const Node> Node::select_nodes(const XPath& xpath) const
+    {
+        return this->select<const Node>(xpath);
+    }
+
+
+    bool Node::exists(const std::string& xpath) const
+    {
+        return FindNodeset::test(cobj, xpath);
+    }
+
+
+    bool Node::exists(const XPath& xpath) const
+    {
+        return FindNodeset::test(cobj, xpath);
+    }
+
+
+    size_t Node::count(const std::string& xpath) const
+    {
+        FindNodeset search(cobj, xpath, XPATH_NODESET);
+        const xmlNodeSet* nodeset = search;
+        return nodeset != NULL ? nodeset->nodeNr : 0;
+    }
+
+
+    size_t Node::count(const XPath& xpath) const
+    {
+        FindNodeset search(cobj, xpath, XPATH_NODESET);
+        const xmlNodeSet* nodeset = search;
+        return nodeset != NULL ? nodeset->nodeNr : 0;
+    }
+
+
     std::string Node::query_string(const std::string& xpath) const
     {
         FindNodeset search(cobj, xpath);
-        const xmlXPathObject* result = search;
+        return get_string(search);
+    }
+
+
+    double Node::query_number(const std::string& xpath) const
+    {
+        FindNodeset search(cobj, xpath);
+        return get_number(search);
+    }
+
+
+    std::string Node::query_string(const XPath& xpath) const
+    {
+        FindNodeset search(cobj, xpath);
+        return get_string(search);
+    }
 
+
+    double Node::query_number(const XPath& xpath) const
+    {
+        FindNodeset search(cobj, xpath);
+        return get_number(search);
+    }
+
+
+    std::string Node::get_string(const xmlXPathObject* result)
+    {
         std::string value;
         if (result->type == XPATH_STRING)
         {
@@ -131,7 +300,7 @@ namespace xml
                 // to other text nodes.
                 for (int i = 0; i != nodeset->nodeNr; i++)
                 {
-                    const Node* node = reinterpret_cast<const Node*>(nodeset->nodeTab[i]->_private);
+                    const Node* node = get_wrapper(nodeset->nodeTab[i]);
                     value.append(node->get_value());
                 }
             }
@@ -141,11 +310,8 @@ namespace xml
     }
 
 
-    double Node::query_number(const std::string& xpath) const
+    double Node::get_number(const xmlXPathObject* result)
     {
-        FindNodeset search(cobj, xpath);
-        const xmlXPathObject* result = search;
-
         double value = 0.0;
         if (result->type == XPATH_NUMBER)
         {
@@ -160,7 +326,7 @@ namespace xml
             const xmlNodeSet* nodeset = result->nodesetval;
             if (! xmlXPathNodeSetIsEmpty(nodeset))
             {
-                const Node* const node = reinterpret_cast<const Node*>(nodeset->nodeTab[0]->_private);
+                const Node* const node = get_wrapper(nodeset->nodeTab[0]);
                 value = from_string<double>(node->get_value());
             }
         }
@@ -169,31 +335,148 @@ namespace xml
     }
 
 
+    Node::FindNodeset::FindNodeset(xmlNode *const cobj, const std::string &xpath, const xmlXPathObjectType type, const size_t limit)
+    : FindNodeset(cobj, xpath.c_str(), type, limit) {}
 
-    Node::FindNodeset::FindNodeset(xmlNode *const cobj, const std::string &xpath, const xmlXPathObjectType type)
-    {
-        ctxt = xmlXPathNewContext(cobj->doc);
-        ctxt->node = cobj;
 
-        result = xmlXPathEval(reinterpret_cast<const xmlChar*>(xpath.c_str()), ctxt);
-        if (!result)
+    Node::FindNodeset::FindNodeset(xmlNode *const cobj, const char *xpath, const xmlXPathObjectType type, const size_t limit)
+    : ctxt(NULL), owns_context(false), result(NULL)
+    {
+        // Plain child paths are evaluated by walking the tree.
+        const SimplePath simple(xpath);
+        if (simple.is_simple())
         {
-            xmlXPathFreeContext(ctxt);
-            throw InvalidXPath(xpath);
+            result = simple.evaluate(cobj, limit);
+            if (result != NULL)
+            {
+                check(xpath, type);
+                return;
+            }
         }
 
-        if (type != XPATH_UNDEFINED && result->type != type)
+        if (XPathCache::get_capacity() != 0)
         {
-            xmlXPathFreeObject(result);
-            xmlXPathFreeContext(ctxt);
-            throw Exception("Unsuported query.");
+            // Keep a reference, the cache may evict the expression while
+            // it is being evaluated.
+            std::shared_ptr<const XPath> compiled = XPathCache::get(xpath);
+            acquire_context(cobj);
+            result = xmlXPathCompiledEval(compiled->get_cobj(), ctxt);
+        }
+        else
+        {
+            acquire_context(cobj);
+            result = xmlXPathEval(reinterpret_cast<const xmlChar*>(xpath), ctxt);
         }
+        check(xpath, type);
+    }
+
+
+    Node::FindNodeset::FindNodeset(xmlNode *const cobj, const XPath &xpath, const xmlXPathObjectType type, const size_t)
+    : ctxt(NULL), owns_context(false), result(NULL)
+    {
+        acquire_context(cobj);
+        result = xmlXPathCompiledEval(xpath.get_cobj(), ctxt);
+        check(xpath.get_expression().c_str(), type);
+    }
+
+
+    Node::FindNodeset::FindNodeset(xmlNode *const cobj)
+    : ctxt(NULL), owns_context(false), result(NULL)
+    {
+        acquire_context(cobj);
     }
 
 
     Node::FindNodeset::~FindNodeset()
     {
         xmlXPathFreeObject(result);
-        xmlXPathFreeContext(ctxt);
+        release_context();
+    }
+
+
+    bool Node::FindNodeset::test(xmlNode *const cobj, const std::string &xpath)
+    {
+        const SimplePath simple(xpath);
+        if (simple.is_simple())
+        {
+            xmlXPathObject* result = simple.evaluate(cobj, 1);
+            if (result != NULL)
+            {
+                const bool found = result->nodesetval->nodeNr != 0;
+                xmlXPathFreeObject(result);
+                return found;
+            }
+        }
+
+        if (XPathCache::get_capacity() != 0)
+        {
+            return test(cobj, *XPathCache::get(xpath));
+        }
+        return test(cobj, XPath(xpath));
+    }
+
+
+    bool Node::FindNodeset::test(xmlNode *const cobj, const XPath &xpath)
+    {
+        FindNodeset search(cobj);
+        const int result = xmlXPathCompiledEvalToBoolean(xpath.get_cobj(), search.ctxt);
+        if (result < 0)
+        {
+            throw InvalidXPath(xpath.get_expression());
+        }
+        return result != 0;
+    }
+
+
+    void Node::FindNodeset::acquire_context(xmlNode *const cobj)
+    {
+        // Nodes of a Document use its cached per thread context, others
+        // (such as nodes expanded by a Reader) get a temporary one.
+        const Document* document = NULL;
+        if (cobj->doc != NULL)
+        {
+            document = reinterpret_cast<const Document*>(cobj->doc->_private);
+        }
+
+        if (document != NULL)
+        {
+            ctxt = document->get_xpath_context();
+        }
+        else
+        {
+            ctxt = xmlXPathNewContext(cobj->doc);
+            owns_context = true;
+        }
+
+        ctxt->node              = cobj;
+        ctxt->contextSize       = -1;
+        ctxt->proximityPosition = -1;
+    }
+
+
+    void Node::FindNodeset::release_context()
+    {
+        if (owns_context)
+        {
+            xmlXPathFreeContext(ctxt);
+        }
+        ctxt = NULL;
+    }
+
+
+    void Node::FindNodeset::check(const char *xpath, const xmlXPathObjectType type)
+    {
+        if (!result)
+        {
+            release_context();
+            throw InvalidXPath(xpath);
+        }
+
+        if (type != XPATH_UNDEFINED && result->type != type)
+        {
+            xmlXPathFreeObject(result);
+            release_context();
+            throw Exception("Unsuported query.");
+        }
     }
 }
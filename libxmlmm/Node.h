@@ -22,15 +22,111 @@
 #pragma once
 
 #include <string>
+#include <string_view>
 #include <vector>
 #include <libxml/tree.h>
 #include <libxml/xpath.h>
 
 #include "defines.h"
+#include "utils.h"
+#include "XPath.h"
+#include "NodeSetView.h"
 
 namespace xml
 {
+    class Node;
     class Element;
+    class Content;
+    class Text;
+    class CData;
+    class Comment;
+    class ProcessingInstruction;
+    class Attribute;
+
+    /**
+     * Map a wrapper class to the libxml node types it wraps.
+     *
+     * Used by Node::is and Node::as, only the specialized classes can be
+     * checked.
+     **/
+    template <typename T>
+    struct node_type_traits;
+
+    template <typename T>
+    struct node_type_traits<const T> : node_type_traits<T> {};
+
+    template <>
+    struct node_type_traits<Node>
+    {
+        static bool match(xmlElementType)
+        {
+            return true;
+        }
+    };
+
+    template <>
+    struct node_type_traits<Element>
+    {
+        static bool match(xmlElementType type)
+        {
+            return type == XML_ELEMENT_NODE;
+        }
+    };
+
+    template <>
+    struct node_type_traits<Content>
+    {
+        static bool match(xmlElementType type)
+        {
+            return type == XML_TEXT_NODE || type == XML_CDATA_SECTION_NODE ||
+                   type == XML_COMMENT_NODE || type == XML_PI_NODE;
+        }
+    };
+
+    template <>
+    struct node_type_traits<Text>
+    {
+        static bool match(xmlElementType type)
+        {
+            return type == XML_TEXT_NODE;
+        }
+    };
+
+    template <>
+    struct node_type_traits<CData>
+    {
+        static bool match(xmlElementType type)
+        {
+            return type == XML_CDATA_SECTION_NODE;
+        }
+    };
+
+    template <>
+    struct node_type_traits<Comment>
+    {
+        static bool match(xmlElementType type)
+        {
+            return type == XML_COMMENT_NODE;
+        }
+    };
+
+    template <>
+    struct node_type_traits<ProcessingInstruction>
+    {
+        static bool match(xmlElementType type)
+        {
+            return type == XML_PI_NODE;
+        }
+    };
+
+    template <>
+    struct node_type_traits<Attribute>
+    {
+        static bool match(xmlElementType type)
+        {
+            return type == XML_ATTRIBUTE_NODE;
+        }
+    };
 
     /**
      * XML DOM Node
@@ -54,6 +150,15 @@ namespace xml
          **/
         virtual ~Node();
 
+        /**
+         * Allocate wrappers from the wrapper pool.
+         *
+         * @{
+         **/
+        static void* operator new(size_t size);
+        static void operator delete(void* ptr, size_t size);
+        /** @} **/
+
         /**
          * Get the node's path
          *
@@ -93,6 +198,12 @@ namespace xml
          **/
         Node* find_node(const std::string& xpath);
         const Node* find_node(const std::string& xpath) const;
+        Node* find_node(const XPath& xpath);
+        const Node* find_node(const XPath& xpath) const;
+        Node* find_node(const char* xpath);
+        const Node* find_node(const char* xpath) const;
+        Node* find_node(std::string_view xpath);
+        const Node* find_node(std::string_view xpath) const;
         /** @} **/
 
         /**
@@ -108,6 +219,62 @@ namespace xml
          **/
         std::vector<Node*> find_nodes(const std::string& xpath);
         std::vector<const Node*> find_nodes(const std::string& xpath) const;
+        std::vector<Node*> find_nodes(const XPath& xpath);
+        std::vector<const Node*> find_nodes(const XPath& xpath) const;
+        std::vector<Node*> find_nodes(const char* xpath);
+        std::vector<const Node*> find_nodes(const char* xpath) const;
+        std::vector<Node*> find_nodes(std::string_view xpath);
+        std::vector<const Node*> find_nodes(std::string_view xpath) const;
+        /** @} **/
+
+        /**
+         * Select a set of nodes.
+         *
+         * Unlike find_nodes, the nodes are not copied into a vector, but
+         * are wrapped as they are iterated.
+         *
+         * @param xpath the XPath relative to this node
+         *
+         * @return a view of the nodes found
+         *
+         * @{
+         **/
+        NodeSetView<Node> select_nodes(const std::string& xpath);
+        NodeSetView<const Node> select_nodes(const std::string& xpath) const;
+        NodeSetView<Node> select_nodes(const XPath& xpath);
+        NodeSetView<const Node> select_nodes(const XPath& xpath) const;
+        /** @} **/
+
+        /**
+         * Check if a query has a result.
+         *
+         * The result of the query is converted to a boolean, so for node
+         * set queries this checks that at least one node matches. The
+         * evaluation stops at the first match where possible.
+         *
+         * @param xpath the XPath relative to this node
+         *
+         * @return true if the query has a result
+         *
+         * @{
+         **/
+        bool exists(const std::string& xpath) const;
+        bool exists(const XPath& xpath) const;
+        /** @} **/
+
+        /**
+         * Count the nodes matching a query.
+         *
+         * No wrappers are created for the nodes.
+         *
+         * @param xpath the XPath relative to this node
+         *
+         * @return the number of nodes found
+         *
+         * @{
+         **/
+        size_t count(const std::string& xpath) const;
+        size_t count(const XPath& xpath) const;
         /** @} **/
 
         /**
@@ -123,6 +290,8 @@ namespace xml
          **/
         std::string query_string(const std::string& xpath) const;
         double query_number(const std::string& xpath) const;
+        std::string query_string(const XPath& xpath) const;
+        double query_number(const XPath& xpath) const;
         /** @} **/
 
         /**
@@ -130,6 +299,50 @@ namespace xml
          **/
         virtual std::string get_value() const = 0;
 
+        /**
+         * Get the type of this node.
+         **/
+        xmlElementType type() const
+        {
+            return cobj->type;
+        }
+
+        /**
+         * Check if this node is of a given type.
+         *
+         * This compares the type of the underlying node and is cheaper than
+         * a dynamic_cast.
+         *
+         * @code
+         * if (node->is<xml::Element>())
+         * @endcode
+         **/
+        template <typename T>
+        bool is() const
+        {
+            return node_type_traits<T>::match(cobj->type);
+        }
+
+        /**
+         * Cast this node to a given type.
+         *
+         * @return this node as T or NULL if it is not of that type.
+         *
+         * @{
+         **/
+        template <typename T>
+        T* as()
+        {
+            return is<T>() ? static_cast<T*>(this) : NULL;
+        }
+
+        template <typename T>
+        const T* as() const
+        {
+            return is<T>() ? static_cast<const T*>(this) : NULL;
+        }
+        /** @} **/
+
     protected:
         /** The wrapped xmlNode object. **/
         xmlNode* cobj;
@@ -137,7 +350,11 @@ namespace xml
         // Helper object to keep our xpath search context.
         struct FindNodeset
         {
-            FindNodeset(xmlNode *const cobj, const std::string &xpath, const xmlXPathObjectType type = XPATH_UNDEFINED);
+            // The limit is a hint that no more nodes are needed, only the
+            // direct walk of simple paths can stop early.
+            FindNodeset(xmlNode *const cobj, const std::string &xpath, const xmlXPathObjectType type = XPATH_UNDEFINED, const size_t limit = 0);
+            FindNodeset(xmlNode *const cobj, const char *xpath, const xmlXPathObjectType type = XPATH_UNDEFINED, const size_t limit = 0);
+            FindNodeset(xmlNode *const cobj, const XPath &xpath, const xmlXPathObjectType type = XPATH_UNDEFINED, const size_t limit = 0);
             ~FindNodeset();
 
             operator xmlXPathObject* ()
@@ -150,40 +367,74 @@ namespace xml
                 return result->nodesetval;
             }
 
+            xmlXPathObject* release()
+            {
+                xmlXPathObject* tmp = result;
+                result = NULL;
+                return tmp;
+            }
+
+            // Evaluate the query as boolean, stopping at the first match.
+            static bool test(xmlNode *const cobj, const std::string &xpath);
+            static bool test(xmlNode *const cobj, const XPath &xpath);
+
         private:
             xmlXPathContext* ctxt;
+            bool owns_context;
             xmlXPathObject* result;
+
+            explicit FindNodeset(xmlNode *const cobj);
+
+            void acquire_context(xmlNode *const cobj);
+            void release_context();
+            void check(const char *xpath, const xmlXPathObjectType type);
         };
 
-        template <typename NodeType>
-        NodeType find(const std::string &xpath) const
+        template <typename NodeType, typename Expression>
+        NodeType find(const Expression &xpath) const
         {
-            FindNodeset search(cobj, xpath, XPATH_NODESET);
+            FindNodeset search(cobj, xpath, XPATH_NODESET, 1);
             const xmlNodeSet* nodeset = search;
             if (!nodeset || nodeset->nodeNr == 0)
             {
                 return NULL;
             }
-            return reinterpret_cast<NodeType>(nodeset->nodeTab[0]->_private);
+            return static_cast<NodeType>(get_wrapper(nodeset->nodeTab[0]));
         }
 
-        template <typename NodeType>
-        std::vector<NodeType> find_all(const std::string &xpath) const
+        template <typename NodeType, typename Expression>
+        std::vector<NodeType> find_all(const Expression &xpath) const
         {
             FindNodeset search(cobj, xpath, XPATH_NODESET);
             const xmlNodeSet* nodeset = search;
             std::vector<NodeType> nodes;
             if (nodeset != NULL)
             {
+                nodes.reserve(nodeset->nodeNr);
                 for (int i = 0; i != nodeset->nodeNr; i++)
                 {
-                    nodes.push_back(reinterpret_cast<NodeType>(nodeset->nodeTab[i]->_private));
+                    nodes.push_back(static_cast<NodeType>(get_wrapper(nodeset->nodeTab[i])));
                 }
             }
             return nodes;
         }
 
+        template <typename NodeType, typename Expression>
+        NodeSetView<NodeType> select(const Expression &xpath) const
+        {
+            FindNodeset search(cobj, xpath, XPATH_NODESET);
+            return NodeSetView<NodeType>(search.release());
+        }
+
+        /** Get the string value of an XPath result. **/
+        static std::string get_string(const xmlXPathObject* result);
+
+        /** Get the number value of an XPath result. **/
+        static double get_number(const xmlXPathObject* result);
+
     private:
+        friend class TreeWalker;
+
         Node(const Node&);
         Node& operator = (const Node&);
     };
@@ -0,0 +1,366 @@
+//
+// Copyright (c) 2008-2020 Sean Farrell
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of
+// this software and associated documentation files (the "Software"), to deal in
+// the Software without restriction, including without limitation the rights to use,
+// copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the
+// Software, and to permit persons to whom the Software is furnished to do so,
+// subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+// INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+// PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+// HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+// OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+// SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+
+#include "NodePool.h"
+
+#include <new>
+#include <mutex>
+#include <cstdlib>
+
+namespace xml
+{
+    struct Slab;
+
+    // Every block starts with a pointer to its slab, the wrapper follows.
+    // While the block is free, the wrapper's space holds the list link.
+    struct Block
+    {
+        Slab*  slab;
+        Block* next;
+    };
+
+    // Large enough for the slab pointer and every wrapper class; they only
+    // hold a vtable and the xmlNode pointer.
+    static const size_t block_size  = 32;
+    static const size_t header_size = sizeof(Slab*);
+    static const size_t slab_blocks = 1024;
+    // Once a thread's cache grows past this, half of it is handed back.
+    static const size_t cache_limit = 4 * slab_blocks;
+    // The number of empty slabs kept instead of freeing them.
+    static const size_t spare_slabs = 2;
+
+    // The header of a slab, its blocks follow. Slabs with free blocks in
+    // the shared pool are linked in a list, partly used ones before empty
+    // ones, so that empty slabs are the last to be used again.
+    struct Slab
+    {
+        Slab*  prev;
+        Slab*  next;
+        Block* free;
+        size_t free_count;
+    };
+
+    // The shared pool. It is deliberately leaked, so that wrappers
+    // released during static destruction still have somewhere to go.
+    struct SharedPool
+    {
+        std::mutex mutex;
+        Slab*  first;
+        Slab*  last;
+        size_t slab_count;
+        size_t empty_count;
+        size_t free_count;
+    };
+
+    static SharedPool& get_shared_pool()
+    {
+        static SharedPool* pool = new SharedPool();
+        return *pool;
+    }
+
+    static void* get_payload(Block* block)
+    {
+        return reinterpret_cast<char*>(block) + header_size;
+    }
+
+    static Block* get_block(void* payload)
+    {
+        return reinterpret_cast<Block*>(static_cast<char*>(payload) - header_size);
+    }
+
+    // The following helpers expect the pool's mutex to be held.
+
+    static void link_front(SharedPool& pool, Slab* slab)
+    {
+        slab->prev = NULL;
+        slab->next = pool.first;
+        if (pool.first != NULL)
+        {
+            pool.first->prev = slab;
+        }
+        else
+        {
+            pool.last = slab;
+        }
+        pool.first = slab;
+    }
+
+    static void link_back(SharedPool& pool, Slab* slab)
+    {
+        slab->prev = pool.last;
+        slab->next = NULL;
+        if (pool.last != NULL)
+        {
+            pool.last->next = slab;
+        }
+        else
+        {
+            pool.first = slab;
+        }
+        pool.last = slab;
+    }
+
+    static void unlink(SharedPool& pool, Slab* slab)
+    {
+        if (slab->prev != NULL)
+        {
+            slab->prev->next = slab->next;
+        }
+        else
+        {
+            pool.first = slab->next;
+        }
+        if (slab->next != NULL)
+        {
+            slab->next->prev = slab->prev;
+        }
+        else
+        {
+            pool.last = slab->prev;
+        }
+    }
+
+    // Return a block to its slab and free the slab once it is empty.
+    static void put_block(SharedPool& pool, Block* block)
+    {
+        Slab* slab = block->slab;
+        if (slab == NULL)
+        {
+            // Allocated from the heap while its thread was shutting down.
+            ::operator delete(block);
+            return;
+        }
+
+        block->next = slab->free;
+        slab->free  = block;
+        slab->free_count++;
+        pool.free_count++;
+
+        if (slab->free_count == 1)
+        {
+            link_front(pool, slab);
+        }
+        else if (slab->free_count == slab_blocks)
+        {
+            unlink(pool, slab);
+            if (pool.empty_count < spare_slabs)
+            {
+                link_back(pool, slab);
+                pool.empty_count++;
+            }
+            else
+            {
+                pool.free_count -= slab_blocks;
+                pool.slab_count--;
+                std::free(slab);
+            }
+        }
+    }
+
+    // Take a free block from the shared pool, NULL if there is none.
+    static Block* take_block(SharedPool& pool)
+    {
+        Slab* slab = pool.first;
+        if (slab == NULL)
+        {
+            return NULL;
+        }
+
+        if (slab->free_count == slab_blocks)
+        {
+            pool.empty_count--;
+        }
+        Block* block = slab->free;
+        slab->free   = block->next;
+        slab->free_count--;
+        pool.free_count--;
+        if (slab->free_count == 0)
+        {
+            unlink(pool, slab);
+        }
+        return block;
+    }
+
+    // Move count blocks of list to the shared pool.
+    static void give_back(Block*& list, size_t count)
+    {
+        SharedPool& pool = get_shared_pool();
+        std::lock_guard<std::mutex> lock(pool.mutex);
+        for (size_t i = 0; i < count && list != NULL; i++)
+        {
+            Block* block = list;
+            list = block->next;
+            put_block(pool, block);
+        }
+    }
+
+    // The per thread cache of free blocks. These are plain values, so that
+    // they stay usable after the flusher ran at thread exit.
+    static thread_local Block* cache_free  = NULL;
+    static thread_local size_t cache_count = 0;
+    static thread_local bool   cache_alive = true;
+
+    // Hands the cache back to the shared pool when the thread exits.
+    struct CacheFlusher
+    {
+        void touch() {}
+
+        ~CacheFlusher()
+        {
+            give_back(cache_free, cache_count);
+            cache_count = 0;
+            cache_alive = false;
+        }
+    };
+
+    static thread_local CacheFlusher flusher;
+
+    // Refill the thread cache from the shared pool or a new slab.
+    static void refill()
+    {
+        flusher.touch();
+
+        SharedPool& pool = get_shared_pool();
+        {
+            std::lock_guard<std::mutex> lock(pool.mutex);
+            while (cache_count < slab_blocks)
+            {
+                Block* block = take_block(pool);
+                if (block == NULL)
+                {
+                    break;
+                }
+                block->next = cache_free;
+                cache_free  = block;
+                cache_count++;
+            }
+        }
+
+        if (cache_free == NULL)
+        {
+            Slab* slab = static_cast<Slab*>(std::malloc(sizeof(Slab) + block_size * slab_blocks));
+            if (slab == NULL)
+            {
+                throw std::bad_alloc();
+            }
+            slab->prev       = NULL;
+            slab->next       = NULL;
+            slab->free       = NULL;
+            slab->free_count = 0;
+
+            char* blocks = reinterpret_cast<char*>(slab + 1);
+            for (size_t i = 0; i < slab_blocks; i++)
+            {
+                Block* block = reinterpret_cast<Block*>(blocks + i * block_size);
+                block->slab  = slab;
+                block->next  = cache_free;
+                cache_free   = block;
+            }
+            cache_count = slab_blocks;
+
+            std::lock_guard<std::mutex> lock(pool.mutex);
+            pool.slab_count++;
+        }
+    }
+
+
+    void* NodePool::allocate(size_t size)
+    {
+        if (size > block_size - header_size)
+        {
+            return ::operator new(size);
+        }
+
+        if (!cache_alive)
+        {
+            // The thread is shutting down, take a block straight from the
+            // shared pool or the heap.
+            SharedPool& pool = get_shared_pool();
+            std::lock_guard<std::mutex> lock(pool.mutex);
+            Block* block = take_block(pool);
+            if (block == NULL)
+            {
+                block = static_cast<Block*>(::operator new(block_size));
+                block->slab = NULL;
+            }
+            return get_payload(block);
+        }
+
+        if (cache_free == NULL)
+        {
+            refill();
+        }
+
+        Block* block = cache_free;
+        cache_free   = block->next;
+        cache_count--;
+        return get_payload(block);
+    }
+
+
+    void NodePool::release(void* ptr, size_t size)
+    {
+        if (ptr == NULL)
+        {
+            return;
+        }
+
+        if (size > block_size - header_size)
+        {
+            ::operator delete(ptr);
+            return;
+        }
+
+        Block* block = get_block(ptr);
+        if (!cache_alive)
+        {
+            // The thread is shutting down, go straight to the shared pool.
+            block->next = NULL;
+            give_back(block, 1);
+            return;
+        }
+
+        // A thread may only ever free wrappers, it needs the flusher too.
+        flusher.touch();
+
+        block->next = cache_free;
+        cache_free  = block;
+        cache_count++;
+        if (cache_count > cache_limit)
+        {
+            const size_t count = cache_count / 2;
+            give_back(cache_free, count);
+            cache_count -= count;
+        }
+    }
+
+
+    NodePool::Statistics NodePool::get_statistics()
+    {
+        SharedPool& pool = get_shared_pool();
+        std::lock_guard<std::mutex> lock(pool.mutex);
+        Statistics statistics;
+        statistics.slabs       = pool.slab_count;
+        statistics.free_blocks = pool.free_count;
+        statistics.used_blocks = pool.slab_count * slab_blocks - pool.free_count;
+        return statistics;
+    }
+}
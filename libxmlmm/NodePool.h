@@ -0,0 +1,80 @@
+//
+// Copyright (c) 2008-2020 Sean Farrell
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of
+// this software and associated documentation files (the "Software"), to deal in
+// the Software without restriction, including without limitation the rights to use,
+// copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the
+// Software, and to permit persons to whom the Software is furnished to do so,
+// subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+// INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+// PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+// HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+// OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+// SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+
+#pragma once
+
+#include <cstddef>
+
+#include "defines.h"
+
+namespace xml
+{
+    /**
+     * Slab allocator for node wrappers.
+     *
+     * @note This class is an internal helper class. Wrappers are small,
+     * fixed size and created and destroyed in large numbers, so they are
+     * carved from slabs instead of allocating each one on the heap. Every
+     * thread keeps a cache of free blocks, so allocation and release
+     * normally take no lock. Once all blocks of a slab are back in the
+     * shared pool the slab is returned to the system; only a few empty
+     * slabs are kept for later wrappers.
+     **/
+    class LIBXMLMM_EXPORT NodePool
+    {
+    public:
+        /**
+         * Allocate memory for a wrapper.
+         *
+         * Requests larger than a pool block are passed on to the heap.
+         **/
+        static void* allocate(size_t size);
+
+        /**
+         * Release memory of a wrapper.
+         *
+         * @param ptr The memory returned by allocate.
+         * @param size The size passed to allocate.
+         **/
+        static void release(void* ptr, size_t size);
+
+        /**
+         * Usage Statistics
+         **/
+        struct Statistics
+        {
+            /** The number of slabs allocated from the system. **/
+            size_t slabs;
+            /** The number of free blocks in the shared pool. **/
+            size_t free_blocks;
+            /** The number of blocks in use or in per thread caches. **/
+            size_t used_blocks;
+        };
+
+        /**
+         * Get the usage statistics of the pool.
+         **/
+        static Statistics get_statistics();
+
+    private:
+        NodePool();
+    };
+}
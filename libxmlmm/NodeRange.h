@@ -0,0 +1,137 @@
+//
+// Copyright (c) 2008-2020 Sean Farrell
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of
+// this software and associated documentation files (the "Software"), to deal in
+// the Software without restriction, including without limitation the rights to use,
+// copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the
+// Software, and to permit persons to whom the Software is furnished to do so,
+// subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+// INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+// PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+// HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+// OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+// SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+
+#pragma once
+
+#include <iterator>
+#include <libxml/tree.h>
+
+#include "defines.h"
+#include "utils.h"
+
+namespace xml
+{
+    /**
+     * Range over the Children of a Node
+     *
+     * The range walks the sibling links of the underlying nodes in place
+     * and wraps each node only as it is visited; it allocates nothing.
+     *
+     * @code
+     * for (xml::Node* child : element->children())
+     * {
+     *     ...
+     * }
+     * @endcode
+     *
+     * @note The range must not be used after the document is freed, and
+     * the iterators are invalidated when the visited node is removed.
+     **/
+    template <typename NodeType>
+    class NodeRange
+    {
+    public:
+        /**
+         * Iterator over the nodes of the range.
+         **/
+        class iterator
+        {
+        public:
+            typedef std::forward_iterator_tag iterator_category;
+            typedef NodeType* value_type;
+            typedef std::ptrdiff_t difference_type;
+            typedef NodeType** pointer;
+            typedef NodeType* reference;
+
+            iterator()
+            : node(NULL) {}
+
+            explicit iterator(xmlNode* node)
+            : node(node) {}
+
+            NodeType* operator * () const
+            {
+                return static_cast<NodeType*>(get_wrapper(node));
+            }
+
+            iterator& operator ++ ()
+            {
+                node = node->next;
+                return *this;
+            }
+
+            iterator operator ++ (int)
+            {
+                iterator tmp(*this);
+                node = node->next;
+                return tmp;
+            }
+
+            bool operator == (const iterator& other) const
+            {
+                return node == other.node;
+            }
+
+            bool operator != (const iterator& other) const
+            {
+                return node != other.node;
+            }
+
+        private:
+            xmlNode* node;
+        };
+
+        /**
+         * Create a range starting at the given node.
+         *
+         * @param first The first node of a sibling list, may be NULL.
+         **/
+        explicit NodeRange(xmlNode* first)
+        : first(first) {}
+
+        /**
+         * Check if the range is empty.
+         **/
+        bool empty() const
+        {
+            return first == NULL;
+        }
+
+        /**
+         * Get an iterator to the first node.
+         **/
+        iterator begin() const
+        {
+            return iterator(first);
+        }
+
+        /**
+         * Get an iterator past the last node.
+         **/
+        iterator end() const
+        {
+            return iterator();
+        }
+
+    private:
+        xmlNode* first;
+    };
+}
@@ -0,0 +1,175 @@
+//
+// Copyright (c) 2008-2020 Sean Farrell
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of
+// this software and associated documentation files (the "Software"), to deal in
+// the Software without restriction, including without limitation the rights to use,
+// copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the
+// Software, and to permit persons to whom the Software is furnished to do so,
+// subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+// INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+// PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+// HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+// OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+// SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+
+#pragma once
+
+#include <iterator>
+#include <libxml/xpath.h>
+
+#include "defines.h"
+#include "utils.h"
+
+namespace xml
+{
+    /**
+     * Lazy View of an XPath Node Set
+     *
+     * The view owns the result of an XPath query and wraps the nodes only
+     * as they are visited, so that iterating a large result does not
+     * build a vector of all nodes first.
+     *
+     * @code
+     * for (const xml::Element* item : root->select_elements("item"))
+     * {
+     *     ...
+     * }
+     * @endcode
+     *
+     * @note The view does not keep the document alive; it must not be used
+     * after the document is freed or modified.
+     **/
+    template <typename NodeType>
+    class NodeSetView
+    {
+    public:
+        /**
+         * Iterator over the nodes of the set.
+         **/
+        class iterator
+        {
+        public:
+            typedef std::input_iterator_tag iterator_category;
+            typedef NodeType* value_type;
+            typedef std::ptrdiff_t difference_type;
+            typedef NodeType** pointer;
+            typedef NodeType* reference;
+
+            iterator()
+            : nodeset(NULL), index(0) {}
+
+            iterator(const xmlNodeSet* nodeset, int index)
+            : nodeset(nodeset), index(index) {}
+
+            NodeType* operator * () const
+            {
+                return static_cast<NodeType*>(get_wrapper(nodeset->nodeTab[index]));
+            }
+
+            iterator& operator ++ ()
+            {
+                ++index;
+                return *this;
+            }
+
+            iterator operator ++ (int)
+            {
+                iterator tmp(*this);
+                ++index;
+                return tmp;
+            }
+
+            bool operator == (const iterator& other) const
+            {
+                return index == other.index;
+            }
+
+            bool operator != (const iterator& other) const
+            {
+                return index != other.index;
+            }
+
+        private:
+            const xmlNodeSet* nodeset;
+            int index;
+        };
+
+        /**
+         * Take ownership of an XPath result.
+         *
+         * @param result The node set result of an XPath query, may be NULL.
+         **/
+        explicit NodeSetView(xmlXPathObject* result)
+        : result(result) {}
+
+        NodeSetView(NodeSetView&& other)
+        : result(other.result)
+        {
+            other.result = NULL;
+        }
+
+        ~NodeSetView()
+        {
+            xmlXPathFreeObject(result);
+        }
+
+        /**
+         * Get the number of nodes in the set.
+         **/
+        size_t size() const
+        {
+            const xmlNodeSet* nodeset = get_nodeset();
+            return nodeset != NULL ? static_cast<size_t>(nodeset->nodeNr) : 0;
+        }
+
+        /**
+         * Check if the set is empty.
+         **/
+        bool empty() const
+        {
+            return size() == 0;
+        }
+
+        /**
+         * Get the node at the given position.
+         **/
+        NodeType* operator [] (size_t i) const
+        {
+            return static_cast<NodeType*>(get_wrapper(get_nodeset()->nodeTab[i]));
+        }
+
+        /**
+         * Get an iterator to the first node.
+         **/
+        iterator begin() const
+        {
+            return iterator(get_nodeset(), 0);
+        }
+
+        /**
+         * Get an iterator past the last node.
+         **/
+        iterator end() const
+        {
+            return iterator(get_nodeset(), static_cast<int>(size()));
+        }
+
+    private:
+        xmlXPathObject* result;
+
+        const xmlNodeSet* get_nodeset() const
+        {
+            return result != NULL ? result->nodesetval : NULL;
+        }
+
+        NodeSetView(const NodeSetView&);
+        NodeSetView& operator = (const NodeSetView&);
+    };
+}
@@ -0,0 +1,63 @@
+//
+// Copyright (c) 2008-2020 Sean Farrell
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of
+// this software and associated documentation files (the "Software"), to deal in
+// the Software without restriction, including without limitation the rights to use,
+// copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the
+// Software, and to permit persons to whom the Software is furnished to do so,
+// subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+// INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+// PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+// HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+// OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+// SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+
+#include "ParseOptions.h"
+
+#include <libxml/parser.h>
+
+namespace xml
+{
+
+    ParseOptions::ParseOptions()
+    : no_blanks(false), compact(false), huge(false), no_network(false),
+      substitute_entities(false), no_cdata(false), extra_flags(0) {}
+
+
+    int ParseOptions::get_flags() const
+    {
+        int flags = extra_flags;
+        if (no_blanks)
+        {
+            flags |= XML_PARSE_NOBLANKS;
+        }
+        if (compact)
+        {
+            flags |= XML_PARSE_COMPACT;
+        }
+        if (huge)
+        {
+            flags |= XML_PARSE_HUGE;
+        }
+        if (no_network)
+        {
+            flags |= XML_PARSE_NONET;
+        }
+        if (substitute_entities)
+        {
+            flags |= XML_PARSE_NOENT;
+        }
+        if (no_cdata)
+        {
+            flags |= XML_PARSE_NOCDATA;
+        }
+        return flags;
+    }
+}
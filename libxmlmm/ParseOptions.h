@@ -0,0 +1,67 @@
+//
+// Copyright (c) 2008-2020 Sean Farrell
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of
+// this software and associated documentation files (the "Software"), to deal in
+// the Software without restriction, including without limitation the rights to use,
+// copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the
+// Software, and to permit persons to whom the Software is furnished to do so,
+// subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+// INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+// PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+// HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+// OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+// SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+
+#pragma once
+
+#include "defines.h"
+
+namespace xml
+{
+    /**
+     * Parser Options
+     *
+     * The options that control how libxml parses a document. All options
+     * are off by default, which is libxml's default behaviour.
+     **/
+    struct LIBXMLMM_EXPORT ParseOptions
+    {
+        /**
+         * Default Constructor
+         **/
+        ParseOptions();
+
+        /** Drop whitespace only text nodes (XML_PARSE_NOBLANKS). **/
+        bool no_blanks;
+
+        /** Store small text nodes inline (XML_PARSE_COMPACT). **/
+        bool compact;
+
+        /** Lift the limits on depth and size (XML_PARSE_HUGE). **/
+        bool huge;
+
+        /** Forbid network access (XML_PARSE_NONET). **/
+        bool no_network;
+
+        /** Substitute entities (XML_PARSE_NOENT). **/
+        bool substitute_entities;
+
+        /** Merge CDATA as text nodes (XML_PARSE_NOCDATA). **/
+        bool no_cdata;
+
+        /** Additional raw libxml parser flags (xmlParserOption). **/
+        int extra_flags;
+
+        /**
+         * Get the options as libxml parser flags.
+         **/
+        int get_flags() const;
+    };
+}
@@ -0,0 +1,77 @@
+//
+// Copyright (c) 2008-2020 Sean Farrell
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of
+// this software and associated documentation files (the "Software"), to deal in
+// the Software without restriction, including without limitation the rights to use,
+// copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the
+// Software, and to permit persons to whom the Software is furnished to do so,
+// subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+// INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+// PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+// HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+// OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+// SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+
+#include "Parser.h"
+
+#include <climits>
+
+#include "utils.h"
+#include "exceptions.h"
+
+namespace xml
+{
+
+    Parser::Parser()
+    : cobj(xmlNewParserCtxt())
+    {
+        if (cobj == NULL)
+        {
+            throw Exception(get_last_error());
+        }
+    }
+
+
+    Parser::~Parser()
+    {
+        xmlFreeParserCtxt(cobj);
+    }
+
+
+    void Parser::read_from_string(Document& doc, const std::string& xml, const ParseOptions& options)
+    {
+        read_from_buffer(doc, xml.data(), xml.size(), options);
+    }
+
+
+    void Parser::read_from_buffer(Document& doc, const char* data, size_t size, const ParseOptions& options)
+    {
+        if (size > static_cast<size_t>(INT_MAX))
+        {
+            // xmlCtxtReadMemory can not handle this, but such a document
+            // dwarfs the cost of a fresh context anyway.
+            doc.replace(read_memory(data, size, NULL, options.get_flags()));
+            return;
+        }
+        doc.replace(xmlCtxtReadMemory(cobj, data, static_cast<int>(size), NULL, NULL, options.get_flags()));
+    }
+
+
+    void Parser::read_from_buffer(Document& doc, std::string_view xml, const ParseOptions& options)
+    {
+        read_from_buffer(doc, xml.data(), xml.size(), options);
+    }
+
+
+    void Parser::read_from_file(Document& doc, const std::string& file, const ParseOptions& options)
+    {
+        doc.replace(xmlCtxtReadFile(cobj, file.c_str(), NULL, options.get_flags()));
+    }
+}
@@ -0,0 +1,106 @@
+//
+// Copyright (c) 2008-2020 Sean Farrell
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of
+// this software and associated documentation files (the "Software"), to deal in
+// the Software without restriction, including without limitation the rights to use,
+// copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the
+// Software, and to permit persons to whom the Software is furnished to do so,
+// subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+// INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+// PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+// HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+// OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+// SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <libxml/parser.h>
+
+#include "defines.h"
+#include "LibXmlSentry.h"
+#include "ParseOptions.h"
+#include "Document.h"
+
+namespace xml
+{
+    /**
+     * Reusable XML Parser
+     *
+     * Every Document::read_* call sets up and tears down a complete libxml
+     * parser context. The Parser class keeps one context alive and resets
+     * it between documents, which pays off when parsing many small
+     * documents.
+     *
+     * @note A Parser must only be used by one thread at a time.
+     **/
+    class LIBXMLMM_EXPORT Parser
+    {
+    public:
+        /**
+         * Default Constructor
+         **/
+        Parser();
+
+        /**
+         * Destructor
+         **/
+        ~Parser();
+
+        /**
+         * Read a document from string.
+         *
+         * @param doc The document to populate.
+         * @param xml The xml text.
+         * @param options The parser options.
+         *
+         * @exception Exception Throws Exception if the xml is invalid.
+         **/
+        void read_from_string(Document& doc, const std::string& xml, const ParseOptions& options = ParseOptions());
+
+        /**
+         * Read a document from a memory buffer.
+         *
+         * @param doc The document to populate.
+         * @param data The start of the xml data.
+         * @param size The size of the xml data in bytes.
+         * @param options The parser options.
+         *
+         * @exception Exception Throws Exception if the xml is invalid.
+         *
+         * @{
+         **/
+        void read_from_buffer(Document& doc, const char* data, size_t size, const ParseOptions& options = ParseOptions());
+        void read_from_buffer(Document& doc, std::string_view xml, const ParseOptions& options = ParseOptions());
+        /** @} **/
+
+        /**
+         * Read a document from file.
+         *
+         * @param doc The document to populate.
+         * @param file The file to read.
+         * @param options The parser options.
+         *
+         * @exception Exception Throws Exception if the file can not be
+         * read or the xml is invalid.
+         **/
+        void read_from_file(Document& doc, const std::string& file, const ParseOptions& options = ParseOptions());
+
+    private:
+        // Declared first, libxml must be initialized before cobj is created.
+        LibXmlSentry libxml_sentry;
+
+        xmlParserCtxt* cobj;
+
+        Parser(const Parser&);
+        Parser& operator = (const Parser&);
+    };
+}
@@ -0,0 +1,216 @@
+//
+// Copyright (c) 2008-2020 Sean Farrell
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of
+// this software and associated documentation files (the "Software"), to deal in
+// the Software without restriction, including without limitation the rights to use,
+// copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the
+// Software, and to permit persons to whom the Software is furnished to do so,
+// subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+// INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+// PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+// HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+// OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+// SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+
+#include "Reader.h"
+
+#include <climits>
+#include <istream>
+
+#include "utils.h"
+#include "exceptions.h"
+
+namespace xml
+{
+
+    Reader::Reader()
+    : cobj(NULL) {}
+
+
+    Reader::~Reader()
+    {
+        if (cobj != NULL)
+        {
+            xmlFreeTextReader(cobj);
+        }
+    }
+
+
+    void Reader::open_file(const std::string& file, const ParseOptions& options)
+    {
+        open(xmlReaderForFile(file.c_str(), NULL, options.get_flags()));
+    }
+
+
+    void Reader::open_buffer(const char* data, size_t size, const ParseOptions& options)
+    {
+        if (size > static_cast<size_t>(INT_MAX))
+        {
+            throw Exception("xml::Reader::open_buffer(): buffer too large, use open_file");
+        }
+        open(xmlReaderForMemory(data, static_cast<int>(size), NULL, NULL, options.get_flags()));
+    }
+
+
+    void Reader::open_stream(std::istream& is, const ParseOptions& options)
+    {
+        open(xmlReaderForIO(&Reader::read_callback, NULL, &is, NULL, NULL, options.get_flags()));
+    }
+
+
+    bool Reader::read()
+    {
+        if (cobj == NULL)
+        {
+            throw Exception("xml::Reader::read(): nothing opened");
+        }
+
+        int result = xmlTextReaderRead(cobj);
+        if (result == -1)
+        {
+            throw Exception(get_last_error());
+        }
+        return result == 1;
+    }
+
+
+    bool Reader::next()
+    {
+        if (cobj == NULL)
+        {
+            throw Exception("xml::Reader::next(): nothing opened");
+        }
+
+        int result = xmlTextReaderNext(cobj);
+        if (result == -1)
+        {
+            throw Exception(get_last_error());
+        }
+        return result == 1;
+    }
+
+
+    xmlReaderTypes Reader::get_node_type() const
+    {
+        int type = xmlTextReaderNodeType(cobj);
+        if (type == -1)
+        {
+            return XML_READER_TYPE_NONE;
+        }
+        return static_cast<xmlReaderTypes>(type);
+    }
+
+
+    std::string Reader::get_name() const
+    {
+        const xmlChar* name = xmlTextReaderConstName(cobj);
+        if (name != NULL)
+        {
+            return reinterpret_cast<const char*>(name);
+        }
+        return std::string();
+    }
+
+
+    int Reader::get_depth() const
+    {
+        return xmlTextReaderDepth(cobj);
+    }
+
+
+    bool Reader::has_value() const
+    {
+        return xmlTextReaderHasValue(cobj) == 1;
+    }
+
+
+    std::string Reader::get_value() const
+    {
+        const xmlChar* value = xmlTextReaderConstValue(cobj);
+        if (value != NULL)
+        {
+            return reinterpret_cast<const char*>(value);
+        }
+        return std::string();
+    }
+
+
+    bool Reader::is_empty_element() const
+    {
+        return xmlTextReaderIsEmptyElement(cobj) == 1;
+    }
+
+
+    bool Reader::has_attribute(const std::string& key) const
+    {
+        xmlChar* value = xmlTextReaderGetAttribute(cobj, reinterpret_cast<const xmlChar*>(key.c_str()));
+        if (value == NULL)
+        {
+            return false;
+        }
+        xmlFree(value);
+        return true;
+    }
+
+
+    std::string Reader::get_attribute(const std::string& key) const
+    {
+        xmlChar* value = xmlTextReaderGetAttribute(cobj, reinterpret_cast<const xmlChar*>(key.c_str()));
+        if (value == NULL)
+        {
+            throw NoSuchAttribute(key, get_name());
+        }
+        std::string result(reinterpret_cast<const char*>(value));
+        xmlFree(value);
+        return result;
+    }
+
+
+    Element* Reader::expand()
+    {
+        if (get_node_type() != XML_READER_TYPE_ELEMENT)
+        {
+            throw Exception("xml::Reader::expand(): current node is not an element");
+        }
+
+        xmlNode* node = xmlTextReaderExpand(cobj);
+        if (node == NULL)
+        {
+            throw Exception(get_last_error());
+        }
+        return static_cast<Element*>(get_wrapper(node));
+    }
+
+
+    void Reader::open(xmlTextReader* reader)
+    {
+        if (reader == NULL)
+        {
+            throw Exception(get_last_error());
+        }
+        if (cobj != NULL)
+        {
+            xmlFreeTextReader(cobj);
+        }
+        cobj = reader;
+    }
+
+
+    int Reader::read_callback(void* context, char* buffer, int len)
+    {
+        std::istream* is = reinterpret_cast<std::istream*>(context);
+        is->read(buffer, len);
+        if (is->bad())
+        {
+            return -1;
+        }
+        return static_cast<int>(is->gcount());
+    }
+}
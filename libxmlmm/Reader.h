@@ -0,0 +1,172 @@
+//
+// Copyright (c) 2008-2020 Sean Farrell
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of
+// this software and associated documentation files (the "Software"), to deal in
+// the Software without restriction, including without limitation the rights to use,
+// copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the
+// Software, and to permit persons to whom the Software is furnished to do so,
+// subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+// INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+// PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+// HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+// OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+// SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+
+#pragma once
+
+#include <string>
+#include <iosfwd>
+#include <libxml/xmlreader.h>
+
+#include "defines.h"
+#include "LibXmlSentry.h"
+#include "ParseOptions.h"
+#include "Element.h"
+
+namespace xml
+{
+    /**
+     * XML Pull Reader
+     *
+     * The Reader class is a forward only cursor over a XML document; it is
+     * effectively a wrapper for xmlTextReader. Unlike Document it never
+     * holds more than the current node (and its expanded subtree) in memory
+     * and can thus process documents that are larger than the available
+     * memory.
+     **/
+    class LIBXMLMM_EXPORT Reader
+    {
+    public:
+        /**
+         * Default Constructor
+         **/
+        Reader();
+
+        /**
+         * Destructor
+         **/
+        ~Reader();
+
+        /**
+         * Start reading the given file.
+         *
+         * @exception Exception Throws Exception if the file can not be opened.
+         **/
+        void open_file(const std::string& file, const ParseOptions& options = ParseOptions());
+
+        /**
+         * Start reading from a memory buffer.
+         *
+         * @note The buffer must outlive the reading.
+         *
+         * @exception Exception Throws Exception if the buffer can not be read.
+         **/
+        void open_buffer(const char* data, size_t size, const ParseOptions& options = ParseOptions());
+
+        /**
+         * Start reading from a stream.
+         *
+         * The stream is read in blocks as the reader advances.
+         *
+         * @note The stream must outlive the reading.
+         *
+         * @exception Exception Throws Exception if the stream can not be read.
+         **/
+        void open_stream(std::istream& is, const ParseOptions& options = ParseOptions());
+
+        /**
+         * Move to the next node in document order.
+         *
+         * @return false if the end of the document was reached.
+         *
+         * @exception Exception Throws Exception if the xml is invalid.
+         **/
+        bool read();
+
+        /**
+         * Move to the next node skipping the current node's subtree.
+         *
+         * @return false if the end of the document was reached.
+         *
+         * @exception Exception Throws Exception if the xml is invalid.
+         **/
+        bool next();
+
+        /**
+         * Get the type of the current node.
+         **/
+        xmlReaderTypes get_node_type() const;
+
+        /**
+         * Get the qualified name of the current node.  Empty if none.
+         **/
+        std::string get_name() const;
+
+        /**
+         * Get the depth of the current node in the document.
+         **/
+        int get_depth() const;
+
+        /**
+         * Check if the current node has a value.
+         **/
+        bool has_value() const;
+
+        /**
+         * Get the value of the current node.  Empty if none.
+         **/
+        std::string get_value() const;
+
+        /**
+         * Check if the current node is an empty element, like <tag/>.
+         **/
+        bool is_empty_element() const;
+
+        /**
+         * Check if the current node has a given attribute.
+         **/
+        bool has_attribute(const std::string& key) const;
+
+        /**
+         * Get an attribute of the current node.
+         *
+         * @throws NoSuchAttribute if the attibute does not exist on the
+         * current node.
+         **/
+        std::string get_attribute(const std::string& key) const;
+
+        /**
+         * Expand the subtree of the current element.
+         *
+         * The complete subtree of the current element is read and returned
+         * as Element, so that the usual DOM and XPath API can be used on it.
+         *
+         * @return The expanded element.
+         *
+         * @note The element is only valid until the reader is advanced.
+         *
+         * @exception Exception Throws Exception if the current node is
+         * not an element or the xml is invalid.
+         **/
+        Element* expand();
+
+    private:
+        xmlTextReader* cobj;
+
+        LibXmlSentry libxml_sentry;
+
+        void open(xmlTextReader* reader);
+
+        static int read_callback(void* context, char* buffer, int len);
+
+        Reader(const Reader&);
+        Reader& operator = (const Reader&);
+    };
+}
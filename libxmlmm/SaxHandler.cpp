@@ -0,0 +1,340 @@
+//
+// Copyright (c) 2008-2020 Sean Farrell
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of
+// this software and associated documentation files (the "Software"), to deal in
+// the Software without restriction, including without limitation the rights to use,
+// copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the
+// Software, and to permit persons to whom the Software is furnished to do so,
+// subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+// INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+// PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+// HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+// OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+// SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+
+#include "SaxHandler.h"
+
+#include <cstring>
+#include <istream>
+#include <libxml/SAX2.h>
+
+#include "utils.h"
+#include "exceptions.h"
+#include "MappedFile.h"
+
+namespace xml
+{
+
+    SaxAttributes::SaxAttributes(std::string_view e, int n, const xmlChar** c)
+    : element(e), count(n), cobj(c) {}
+
+
+    size_t SaxAttributes::size() const
+    {
+        return static_cast<size_t>(count);
+    }
+
+
+    std::string_view SaxAttributes::get_name(size_t index) const
+    {
+        // libxml passes five pointers per attribute:
+        // localname, prefix, URI, value start and value end.
+        return reinterpret_cast<const char*>(cobj[index * 5]);
+    }
+
+
+    std::string_view SaxAttributes::get_value(size_t index) const
+    {
+        const xmlChar* begin = cobj[index * 5 + 3];
+        const xmlChar* end   = cobj[index * 5 + 4];
+        return std::string_view(reinterpret_cast<const char*>(begin), end - begin);
+    }
+
+
+    bool SaxAttributes::has_attribute(std::string_view key) const
+    {
+        for (size_t i = 0; i < size(); i++)
+        {
+            if (get_name(i) == key)
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+
+
+    std::string_view SaxAttributes::get_attribute(std::string_view key) const
+    {
+        for (size_t i = 0; i < size(); i++)
+        {
+            if (get_name(i) == key)
+            {
+                return get_value(i);
+            }
+        }
+        throw NoSuchAttribute(std::string(key), std::string(element));
+    }
+
+
+    SaxHandler::SaxHandler()
+    : ctxt(NULL) {}
+
+
+    SaxHandler::~SaxHandler() {}
+
+
+    void SaxHandler::parse_file(const std::string& file, const ParseOptions& options)
+    {
+        MappedFile mapping(file);
+        create_context(options);
+        finish(push_memory(ctxt, mapping.get_data(), mapping.get_size()));
+    }
+
+
+    void SaxHandler::parse_buffer(const char* data, size_t size, const ParseOptions& options)
+    {
+        create_context(options);
+        finish(push_memory(ctxt, data, size));
+    }
+
+
+    void SaxHandler::parse_stream(std::istream& is, const ParseOptions& options)
+    {
+        create_context(options);
+        int result = push_stream(ctxt, is);
+        if (is.bad())
+        {
+            xmlFreeDoc(ctxt->myDoc);
+            xmlFreeParserCtxt(ctxt);
+            ctxt = NULL;
+            throw Exception("xml::SaxHandler::parse_stream(): failed to read from stream");
+        }
+        finish(result);
+    }
+
+
+    void SaxHandler::start_document() {}
+
+
+    void SaxHandler::end_document() {}
+
+
+    void SaxHandler::start_element(std::string_view, const SaxAttributes&) {}
+
+
+    void SaxHandler::end_element(std::string_view) {}
+
+
+    void SaxHandler::characters(std::string_view) {}
+
+
+    void SaxHandler::cdata(std::string_view) {}
+
+
+    void SaxHandler::comment(std::string_view) {}
+
+
+    void SaxHandler::processing_instruction(std::string_view, std::string_view) {}
+
+
+    void SaxHandler::create_context(const ParseOptions& options)
+    {
+        if (ctxt != NULL)
+        {
+            throw Exception("xml::SaxHandler: already parsing");
+        }
+
+        // Start from libxml's SAX2 defaults, so that the DTD and entity
+        // declarations are still handled, and only take over the content.
+        xmlSAXHandler sax;
+        xmlSAXVersion(&sax, 2);
+        sax.startDocument         = &SaxHandler::on_start_document;
+        sax.endDocument           = &SaxHandler::on_end_document;
+        sax.startElementNs        = &SaxHandler::on_start_element;
+        sax.endElementNs          = &SaxHandler::on_end_element;
+        sax.characters            = &SaxHandler::on_characters;
+        sax.ignorableWhitespace   = &SaxHandler::on_characters;
+        if (options.get_flags() & XML_PARSE_NOBLANKS)
+        {
+            sax.ignorableWhitespace = NULL;
+        }
+        sax.cdataBlock            = &SaxHandler::on_cdata;
+        sax.comment               = &SaxHandler::on_comment;
+        sax.processingInstruction = &SaxHandler::on_processing_instruction;
+        sax.reference             = NULL;
+
+        // The SAX2 defaults expect the parser context as user data, the
+        // handler is passed in _private instead.
+        ctxt = xmlCreatePushParserCtxt(&sax, NULL, NULL, 0, NULL);
+        if (ctxt == NULL)
+        {
+            throw Exception(get_last_error());
+        }
+        ctxt->_private = this;
+
+        xmlCtxtUseOptions(ctxt, options.get_flags());
+    }
+
+
+    void SaxHandler::finish(int result)
+    {
+        const bool well_formed = ctxt->wellFormed != 0;
+        // The SAX2 defaults keep the DTD in a document without content.
+        xmlFreeDoc(ctxt->myDoc);
+        ctxt->myDoc = NULL;
+        xmlFreeParserCtxt(ctxt);
+        ctxt = NULL;
+
+        if (error)
+        {
+            std::exception_ptr tmp = error;
+            error = std::exception_ptr();
+            std::rethrow_exception(tmp);
+        }
+        if (result != 0 || !well_formed)
+        {
+            throw Exception(get_last_error());
+        }
+    }
+
+
+    void SaxHandler::abort()
+    {
+        error = std::current_exception();
+        xmlStopParser(ctxt);
+    }
+
+
+    SaxHandler* SaxHandler::get_handler(void* ctxt)
+    {
+        return reinterpret_cast<SaxHandler*>(reinterpret_cast<xmlParserCtxt*>(ctxt)->_private);
+    }
+
+
+    void SaxHandler::on_start_document(void* self)
+    {
+        xmlSAX2StartDocument(self);
+        SaxHandler* handler = get_handler(self);
+        try
+        {
+            handler->start_document();
+        }
+        catch (...)
+        {
+            handler->abort();
+        }
+    }
+
+
+    void SaxHandler::on_end_document(void* self)
+    {
+        SaxHandler* handler = get_handler(self);
+        try
+        {
+            handler->end_document();
+        }
+        catch (...)
+        {
+            handler->abort();
+        }
+    }
+
+
+    void SaxHandler::on_start_element(void* self, const xmlChar* localname, const xmlChar*, const xmlChar*,
+                                      int, const xmlChar**, int nb_attributes, int, const xmlChar** attributes)
+    {
+        SaxHandler* handler = get_handler(self);
+        try
+        {
+            std::string_view name(reinterpret_cast<const char*>(localname));
+            handler->start_element(name, SaxAttributes(name, nb_attributes, attributes));
+        }
+        catch (...)
+        {
+            handler->abort();
+        }
+    }
+
+
+    void SaxHandler::on_end_element(void* self, const xmlChar* localname, const xmlChar*, const xmlChar*)
+    {
+        SaxHandler* handler = get_handler(self);
+        try
+        {
+            handler->end_element(reinterpret_cast<const char*>(localname));
+        }
+        catch (...)
+        {
+            handler->abort();
+        }
+    }
+
+
+    void SaxHandler::on_characters(void* self, const xmlChar* text, int len)
+    {
+        SaxHandler* handler = get_handler(self);
+        try
+        {
+            handler->characters(std::string_view(reinterpret_cast<const char*>(text), len));
+        }
+        catch (...)
+        {
+            handler->abort();
+        }
+    }
+
+
+    void SaxHandler::on_cdata(void* self, const xmlChar* text, int len)
+    {
+        SaxHandler* handler = get_handler(self);
+        try
+        {
+            handler->cdata(std::string_view(reinterpret_cast<const char*>(text), len));
+        }
+        catch (...)
+        {
+            handler->abort();
+        }
+    }
+
+
+    void SaxHandler::on_comment(void* self, const xmlChar* text)
+    {
+        SaxHandler* handler = get_handler(self);
+        try
+        {
+            handler->comment(reinterpret_cast<const char*>(text));
+        }
+        catch (...)
+        {
+            handler->abort();
+        }
+    }
+
+
+    void SaxHandler::on_processing_instruction(void* self, const xmlChar* target, const xmlChar* data)
+    {
+        SaxHandler* handler = get_handler(self);
+        try
+        {
+            std::string_view data_view;
+            if (data != NULL)
+            {
+                data_view = reinterpret_cast<const char*>(data);
+            }
+            handler->processing_instruction(reinterpret_cast<const char*>(target), data_view);
+        }
+        catch (...)
+        {
+            handler->abort();
+        }
+    }
+}
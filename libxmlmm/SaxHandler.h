@@ -0,0 +1,210 @@
+//
+// Copyright (c) 2008-2020 Sean Farrell
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of
+// this software and associated documentation files (the "Software"), to deal in
+// the Software without restriction, including without limitation the rights to use,
+// copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the
+// Software, and to permit persons to whom the Software is furnished to do so,
+// subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+// INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+// PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+// HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+// OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+// SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <iosfwd>
+#include <exception>
+#include <libxml/parser.h>
+
+#include "defines.h"
+#include "LibXmlSentry.h"
+#include "ParseOptions.h"
+
+namespace xml
+{
+    /**
+     * Attributes of a SAX start element event.
+     *
+     * This is a non-owning view on libxml's attribute array; it is only
+     * valid during the start_element call it is passed to.
+     **/
+    class LIBXMLMM_EXPORT SaxAttributes
+    {
+    public:
+        /**
+         * Construct the view.
+         *
+         * @param element The local name of the element.
+         * @param count The number of attributes.
+         * @param cobj libxml's SAX2 attribute array.
+         **/
+        SaxAttributes(std::string_view element, int count, const xmlChar** cobj);
+
+        /**
+         * Get the number of attributes.
+         **/
+        size_t size() const;
+
+        /**
+         * Get the local name of the attribute at index.
+         **/
+        std::string_view get_name(size_t index) const;
+
+        /**
+         * Get the value of the attribute at index.
+         *
+         * @note Unless ParseOptions::substitute_entities is set, entity and
+         * character references in the value are passed as they are, for
+         * example "&#38;".
+         **/
+        std::string_view get_value(size_t index) const;
+
+        /**
+         * Check if a given attribute exists.
+         **/
+        bool has_attribute(std::string_view key) const;
+
+        /**
+         * Get a given attribute.
+         *
+         * @throws NoSuchAttribute if the attibute does not exist.
+         **/
+        std::string_view get_attribute(std::string_view key) const;
+
+    private:
+        std::string_view element;
+        int count;
+        const xmlChar** cobj;
+    };
+
+    /**
+     * SAX Event Handler
+     *
+     * Derive from this class and override the events you are interested in
+     * to process a document without building a tree. All names and text are
+     * passed as non-owning views that are only valid during the call.
+     *
+     * Exceptions thrown from an event stop the parse and are passed on to
+     * the caller of parse_file, parse_buffer or parse_stream.
+     **/
+    class LIBXMLMM_EXPORT SaxHandler
+    {
+    public:
+        /**
+         * Default Constructor
+         **/
+        SaxHandler();
+
+        /**
+         * Destructor
+         **/
+        virtual ~SaxHandler();
+
+        /**
+         * Parse the given file.
+         *
+         * @exception Exception Throws Exception if the file can not be read
+         * or the xml is invalid.
+         **/
+        void parse_file(const std::string& file, const ParseOptions& options = ParseOptions());
+
+        /**
+         * Parse a memory buffer.
+         *
+         * @exception Exception Throws Exception if the xml is invalid.
+         **/
+        void parse_buffer(const char* data, size_t size, const ParseOptions& options = ParseOptions());
+
+        /**
+         * Parse a stream.
+         *
+         * @exception Exception Throws Exception if the stream can not be read
+         * or the xml is invalid.
+         **/
+        void parse_stream(std::istream& is, const ParseOptions& options = ParseOptions());
+
+    protected:
+        /**
+         * The document starts.
+         **/
+        virtual void start_document();
+
+        /**
+         * The document ends.
+         **/
+        virtual void end_document();
+
+        /**
+         * An element starts.
+         *
+         * @param name The local name of the element.
+         * @param attributes The element's attributes.
+         **/
+        virtual void start_element(std::string_view name, const SaxAttributes& attributes);
+
+        /**
+         * An element ends.
+         *
+         * @param name The local name of the element.
+         **/
+        virtual void end_element(std::string_view name);
+
+        /**
+         * Text was read.
+         *
+         * @note The text of one text node may be split over multiple calls.
+         **/
+        virtual void characters(std::string_view text);
+
+        /**
+         * A CDATA section was read.
+         **/
+        virtual void cdata(std::string_view text);
+
+        /**
+         * A comment was read.
+         **/
+        virtual void comment(std::string_view text);
+
+        /**
+         * A processing instruction was read.
+         **/
+        virtual void processing_instruction(std::string_view target, std::string_view data);
+
+    private:
+        xmlParserCtxt* ctxt;
+        std::exception_ptr error;
+
+        LibXmlSentry libxml_sentry;
+
+        void create_context(const ParseOptions& options);
+        void finish(int result);
+        void abort();
+
+        static SaxHandler* get_handler(void* ctxt);
+        static void on_start_document(void* self);
+        static void on_end_document(void* self);
+        static void on_start_element(void* self, const xmlChar* localname, const xmlChar* prefix, const xmlChar* uri,
+                                     int nb_namespaces, const xmlChar** namespaces, int nb_attributes, int nb_defaulted,
+                                     const xmlChar** attributes);
+        static void on_end_element(void* self, const xmlChar* localname, const xmlChar* prefix, const xmlChar* uri);
+        static void on_characters(void* self, const xmlChar* text, int len);
+        static void on_cdata(void* self, const xmlChar* text, int len);
+        static void on_comment(void* self, const xmlChar* text);
+        static void on_processing_instruction(void* self, const xmlChar* target, const xmlChar* data);
+
+        SaxHandler(const SaxHandler&);
+        SaxHandler& operator = (const SaxHandler&);
+    };
+}
@@ -0,0 +1,288 @@
+//
+// Copyright (c) 2008-2020 Sean Farrell
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of
+// this software and associated documentation files (the "Software"), to deal in
+// the Software without restriction, including without limitation the rights to use,
+// copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the
+// Software, and to permit persons to whom the Software is furnished to do so,
+// subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+// INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+// PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+// HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+// OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+// SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+
+#include "SimplePath.h"
+
+#include <libxml/xpathInternals.h>
+
+namespace xml
+{
+    static bool is_name_start(const char c)
+    {
+        return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || c == '_';
+    }
+
+    static bool is_name_char(const char c)
+    {
+        return is_name_start(c) || (c >= '0' && c <= '9') || c == '-' || c == '.';
+    }
+
+    // Scan a name or "*" starting at pos. Only ASCII names are recognized,
+    // anything else is left to libxml2.
+    static std::string_view scan_name(const std::string_view s, size_t& pos)
+    {
+        const size_t start = pos;
+        if (pos < s.size() && s[pos] == '*')
+        {
+            pos++;
+        }
+        else if (pos < s.size() && is_name_start(s[pos]))
+        {
+            while (pos < s.size() && is_name_char(s[pos]))
+            {
+                pos++;
+            }
+        }
+        return s.substr(start, pos - start);
+    }
+
+    static bool is_full(const xmlNodeSet* result, const size_t limit)
+    {
+        return limit != 0 && static_cast<size_t>(result->nodeNr) >= limit;
+    }
+
+    static std::string_view get_name(const xmlChar* name)
+    {
+        return std::string_view(reinterpret_cast<const char*>(name));
+    }
+
+
+    SimplePath::SimplePath(std::string_view expression)
+    : step_count(0), simple(false)
+    {
+        simple = parse(expression);
+    }
+
+
+    bool SimplePath::is_simple() const
+    {
+        return simple;
+    }
+
+
+    xmlXPathObject* SimplePath::evaluate(xmlNode* context, size_t limit) const
+    {
+        if (!simple || context == NULL || context->type != XML_ELEMENT_NODE)
+        {
+            return NULL;
+        }
+
+        xmlNodeSet* result = xmlXPathNodeSetCreate(NULL);
+        if (result == NULL)
+        {
+            return NULL;
+        }
+        if (!visit(context, 0, limit, result))
+        {
+            xmlXPathFreeNodeSet(result);
+            return NULL;
+        }
+        return xmlXPathWrapNodeSet(result);
+    }
+
+
+    bool SimplePath::parse(std::string_view s)
+    {
+        size_t pos = 0;
+        while (pos < s.size())
+        {
+            if (step_count == max_steps)
+            {
+                return false;
+            }
+            Step& step = steps[step_count++];
+            step = Step();
+
+            if (s[pos] == '.')
+            {
+                step.type = SELF_STEP;
+                pos++;
+            }
+            else if (s[pos] == '@')
+            {
+                pos++;
+                step.type = ATTRIBUTE_STEP;
+                step.name = scan_name(s, pos);
+                if (step.name.empty() || pos != s.size())
+                {
+                    return false;
+                }
+            }
+            else
+            {
+                step.type = CHILD_STEP;
+                step.name = scan_name(s, pos);
+                if (step.name.empty())
+                {
+                    return false;
+                }
+
+                if (pos < s.size() && s[pos] == '[')
+                {
+                    pos++;
+                    if (pos == s.size() || s[pos] != '@')
+                    {
+                        return false;
+                    }
+                    pos++;
+                    step.has_predicate = true;
+                    step.predicate_name = scan_name(s, pos);
+                    if (step.predicate_name.empty() || step.predicate_name == "*")
+                    {
+                        return false;
+                    }
+
+                    if (pos < s.size() && s[pos] == '=')
+                    {
+                        pos++;
+                        if (pos == s.size() || (s[pos] != '\'' && s[pos] != '"'))
+                        {
+                            return false;
+                        }
+                        const size_t end = s.find(s[pos], pos + 1);
+                        if (end == std::string_view::npos)
+                        {
+                            return false;
+                        }
+                        step.has_predicate_value = true;
+                        step.predicate_value = s.substr(pos + 1, end - pos - 1);
+                        pos = end + 1;
+                    }
+
+                    if (pos == s.size() || s[pos] != ']')
+                    {
+                        return false;
+                    }
+                    pos++;
+                }
+            }
+
+            if (pos == s.size())
+            {
+                return true;
+            }
+            if (s[pos] != '/' || pos + 1 == s.size())
+            {
+                return false;
+            }
+            pos++;
+        }
+        return false;
+    }
+
+
+    bool SimplePath::visit(xmlNode* node, size_t index, size_t limit, xmlNodeSet* result) const
+    {
+        if (index == step_count)
+        {
+            return xmlXPathNodeSetAddUnique(result, node) == 0;
+        }
+
+        const Step& step = steps[index];
+        switch (step.type)
+        {
+            case SELF_STEP:
+                return visit(node, index + 1, limit, result);
+
+            case CHILD_STEP:
+                for (xmlNode* child = node->children; child != NULL; child = child->next)
+                {
+                    if (child->type == XML_ELEMENT_NODE)
+                    {
+                        bool exact = true;
+                        if (matches(step, child, exact))
+                        {
+                            if (!visit(child, index + 1, limit, result))
+                            {
+                                return false;
+                            }
+                            if (is_full(result, limit))
+                            {
+                                return true;
+                            }
+                        }
+                        else if (!exact)
+                        {
+                            return false;
+                        }
+                    }
+                }
+                return true;
+
+            case ATTRIBUTE_STEP:
+                for (xmlAttr* attr = node->properties; attr != NULL; attr = attr->next)
+                {
+                    if (step.name == "*" || (attr->ns == NULL && get_name(attr->name) == step.name))
+                    {
+                        if (xmlXPathNodeSetAddUnique(result, reinterpret_cast<xmlNode*>(attr)) != 0)
+                        {
+                            return false;
+                        }
+                        if (is_full(result, limit))
+                        {
+                            return true;
+                        }
+                    }
+                }
+                return true;
+        }
+        return false;
+    }
+
+
+    bool SimplePath::matches(const Step& step, xmlNode* element, bool& exact)
+    {
+        if (step.name != "*" && (element->ns != NULL || get_name(element->name) != step.name))
+        {
+            return false;
+        }
+        if (!step.has_predicate)
+        {
+            return true;
+        }
+
+        for (xmlAttr* attr = element->properties; attr != NULL; attr = attr->next)
+        {
+            if (attr->ns == NULL && get_name(attr->name) == step.predicate_name)
+            {
+                if (!step.has_predicate_value)
+                {
+                    return true;
+                }
+
+                // Only plain text values are compared here, values with
+                // entity references are left to libxml2.
+                const xmlNode* text = attr->children;
+                if (text == NULL)
+                {
+                    return step.predicate_value.empty();
+                }
+                if (text->type != XML_TEXT_NODE || text->next != NULL)
+                {
+                    exact = false;
+                    return false;
+                }
+                return get_name(text->content) == step.predicate_value;
+            }
+        }
+        return false;
+    }
+}
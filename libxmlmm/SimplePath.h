@@ -0,0 +1,101 @@
+//
+// Copyright (c) 2008-2020 Sean Farrell
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of
+// this software and associated documentation files (the "Software"), to deal in
+// the Software without restriction, including without limitation the rights to use,
+// copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the
+// Software, and to permit persons to whom the Software is furnished to do so,
+// subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+// INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+// PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+// HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+// OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+// SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+
+#pragma once
+
+#include <string_view>
+#include <libxml/tree.h>
+#include <libxml/xpath.h>
+
+namespace xml
+{
+    /**
+     * Direct evaluation of simple XPath location paths.
+     *
+     * @note This class is an internal helper class. Most queries are plain
+     * relative child paths, such as "a/b/c", "./item", "@id" or
+     * "item[@type='x']". These are evaluated by walking the tree directly
+     * instead of compiling and running them through libxml2. Any other
+     * expression is rejected and must be evaluated by libxml2.
+     *
+     * The recognized subset is a '/' separated list of steps, where each
+     * step is ".", a name or "*" optionally followed by one predicate of
+     * the form [@name], [@name='value'] or [@name="value"]. The last step
+     * may also be "@name" or "@*". Names are unprefixed, so they only
+     * match nodes without namespace, just like in XPath.
+     **/
+    class SimplePath
+    {
+    public:
+        /**
+         * Parse an expression.
+         **/
+        explicit SimplePath(std::string_view expression);
+
+        /**
+         * Check if the expression is in the recognized subset.
+         **/
+        bool is_simple() const;
+
+        /**
+         * Evaluate the expression.
+         *
+         * @param context The context node.
+         * @param limit Stop after this many nodes are found, 0 for all.
+         *
+         * @return A node set result or NULL if the expression can not be
+         * evaluated exactly on this context, such as when the context is
+         * not an element or an attribute value contains entity references.
+         **/
+        xmlXPathObject* evaluate(xmlNode* context, size_t limit = 0) const;
+
+    private:
+        enum StepType
+        {
+            SELF_STEP,
+            CHILD_STEP,
+            ATTRIBUTE_STEP
+        };
+
+        struct Step
+        {
+            StepType         type;
+            std::string_view name;
+            bool             has_predicate;
+            std::string_view predicate_name;
+            bool             has_predicate_value;
+            std::string_view predicate_value;
+        };
+
+        static const size_t max_steps = 16;
+
+        Step   steps[max_steps];
+        size_t step_count;
+        bool   simple;
+
+        bool parse(std::string_view expression);
+        bool visit(xmlNode* node, size_t index, size_t limit, xmlNodeSet* result) const;
+        static bool matches(const Step& step, xmlNode* element, bool& exact);
+
+        SimplePath(const SimplePath&);
+        SimplePath& operator = (const SimplePath&);
+    };
+}
@@ -0,0 +1,93 @@
+//
+// Copyright (c) 2008-2020 Sean Farrell
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of
+// this software and associated documentation files (the "Software"), to deal in
+// the Software without restriction, including without limitation the rights to use,
+// copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the
+// Software, and to permit persons to whom the Software is furnished to do so,
+// subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+// INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+// PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+// HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+// OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+// SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+
+#include "TreeWalker.h"
+
+#include <cassert>
+
+#include "Node.h"
+#include "utils.h"
+
+namespace xml
+{
+
+    TreeWalker::TreeWalker() {}
+
+
+    TreeWalker::~TreeWalker() {}
+
+
+    bool TreeWalker::walk(Node* root)
+    {
+        assert(root != NULL);
+        xmlNode* const top = root->cobj;
+        xmlNode* node = top;
+        while (true)
+        {
+            Node* wrapper = get_wrapper(node);
+            const Action action = wrapper != NULL ? enter(wrapper) : SKIP_CHILDREN;
+            if (action == STOP)
+            {
+                return false;
+            }
+
+            // Only the children of elements belong to the tree, those of
+            // entity references are shared with the declaration.
+            if (action == CONTINUE && node->type == XML_ELEMENT_NODE && node->children != NULL)
+            {
+                node = node->children;
+                continue;
+            }
+
+            // Leave the node and all ancestors that have no more siblings.
+            while (true)
+            {
+                if (wrapper != NULL && leave(wrapper) == STOP)
+                {
+                    return false;
+                }
+                if (node == top)
+                {
+                    return true;
+                }
+                if (node->next != NULL)
+                {
+                    node = node->next;
+                    break;
+                }
+                node = node->parent;
+                wrapper = get_wrapper(node);
+            }
+        }
+    }
+
+
+    TreeWalker::Action TreeWalker::enter(Node*)
+    {
+        return CONTINUE;
+    }
+
+
+    TreeWalker::Action TreeWalker::leave(Node*)
+    {
+        return CONTINUE;
+    }
+}
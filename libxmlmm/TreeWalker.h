@@ -0,0 +1,104 @@
+//
+// Copyright (c) 2008-2020 Sean Farrell
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of
+// this software and associated documentation files (the "Software"), to deal in
+// the Software without restriction, including without limitation the rights to use,
+// copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the
+// Software, and to permit persons to whom the Software is furnished to do so,
+// subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+// INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+// PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+// HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+// OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+// SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+
+#pragma once
+
+#include "defines.h"
+
+namespace xml
+{
+    class Node;
+
+    /**
+     * Depth-First Tree Walker
+     *
+     * Derive from this class and override enter and leave to visit all
+     * nodes below a given node. The walk follows the parent and sibling
+     * links of the document and does not recurse, so it needs no memory
+     * per level and works for arbitrarily deep documents.
+     *
+     * Each visited node is first passed to enter, then its children are
+     * walked, then it is passed to leave. Nodes that are not wrapped, such
+     * as entity references, are not visited.
+     *
+     * Exceptions thrown from enter or leave stop the walk and are passed on
+     * to the caller of walk.
+     *
+     * @note The tree must not be restructured during the walk; changing the
+     * name, attributes or content of the visited nodes is fine.
+     **/
+    class LIBXMLMM_EXPORT TreeWalker
+    {
+    public:
+        /**
+         * How to continue the walk after a node.
+         **/
+        enum Action
+        {
+            /** Continue with the children of the node, if any. **/
+            CONTINUE,
+            /** Do not walk the children, the node is still left. **/
+            SKIP_CHILDREN,
+            /** Stop the walk immediately. **/
+            STOP
+        };
+
+        /**
+         * Default Constructor
+         **/
+        TreeWalker();
+
+        /**
+         * Destructor
+         **/
+        virtual ~TreeWalker();
+
+        /**
+         * Walk the given node and all its descendants.
+         *
+         * @param root The node to start with, it is visited too.
+         *
+         * @return false if the walk was stopped, true otherwise.
+         **/
+        bool walk(Node* root);
+
+    protected:
+        /**
+         * A node is entered, before its children.
+         *
+         * @return CONTINUE to walk the children, SKIP_CHILDREN to skip them
+         * or STOP to end the walk. The default implementation continues.
+         **/
+        virtual Action enter(Node* node);
+
+        /**
+         * A node is left, after its children.
+         *
+         * @return STOP to end the walk, anything else continues. The
+         * default implementation continues.
+         **/
+        virtual Action leave(Node* node);
+
+    private:
+        TreeWalker(const TreeWalker&);
+        TreeWalker& operator = (const TreeWalker&);
+    };
+}
@@ -0,0 +1,73 @@
+//
+// Copyright (c) 2008-2020 Sean Farrell
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of
+// this software and associated documentation files (the "Software"), to deal in
+// the Software without restriction, including without limitation the rights to use,
+// copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the
+// Software, and to permit persons to whom the Software is furnished to do so,
+// subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+// INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+// PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+// HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+// OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+// SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+
+#pragma once
+
+#include <string>
+#include <libxml/xpath.h>
+
+#include "defines.h"
+
+namespace xml
+{
+    /**
+     * Compiled XPath Expression
+     *
+     * Every query that takes the XPath as string parses and compiles the
+     * expression anew. An XPath object is compiled once and can then be
+     * evaluated any number of times against any node or document.
+     **/
+    class LIBXMLMM_EXPORT XPath
+    {
+    public:
+        /**
+         * Compile an expression.
+         *
+         * @param expression The XPath expression.
+         *
+         * @exception InvalidXPath Throws InvalidXPath if the expression
+         * does not compile.
+         **/
+        explicit XPath(const std::string& expression);
+
+        /**
+         * Destructor
+         **/
+        ~XPath();
+
+        /**
+         * Get the source expression.
+         **/
+        const std::string& get_expression() const;
+
+        /**
+         * Get the compiled expression.
+         **/
+        xmlXPathCompExpr* get_cobj() const;
+
+    private:
+        std::string expression;
+        xmlXPathCompExpr* cobj;
+
+        XPath(const XPath&);
+        XPath& operator = (const XPath&);
+    };
+}
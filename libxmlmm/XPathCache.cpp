@@ -0,0 +1,137 @@
+//
+// Copyright (c) 2008-2020 Sean Farrell
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of
+// this software and associated documentation files (the "Software"), to deal in
+// the Software without restriction, including without limitation the rights to use,
+// copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the
+// Software, and to permit persons to whom the Software is furnished to do so,
+// subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+// INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+// PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+// HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+// OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+// SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+
+#include "XPathCache.h"
+
+#include <list>
+#include <mutex>
+#include <atomic>
+#include <unordered_map>
+
+namespace xml
+{
+    typedef std::pair<std::string, std::shared_ptr<const XPath> > CacheEntry;
+
+    // The cache state. It is deliberately leaked, so that queries during
+    // static destruction still find it.
+    struct CacheState
+    {
+        std::mutex mutex;
+        std::atomic<size_t> capacity;
+        // Most recently used first.
+        std::list<CacheEntry> entries;
+        std::unordered_map<std::string, std::list<CacheEntry>::iterator> index;
+        XPathCache::Statistics statistics;
+
+        CacheState()
+        : capacity(0), statistics() {}
+    };
+
+    static CacheState& get_state()
+    {
+        static CacheState* state = new CacheState();
+        return *state;
+    }
+
+    static void trim(CacheState& state, size_t capacity)
+    {
+        while (state.entries.size() > capacity)
+        {
+            state.index.erase(state.entries.back().first);
+            state.entries.pop_back();
+            state.statistics.evictions++;
+        }
+        state.statistics.size = state.entries.size();
+    }
+
+
+    void XPathCache::set_capacity(size_t capacity)
+    {
+        CacheState& state = get_state();
+        std::lock_guard<std::mutex> lock(state.mutex);
+        state.capacity = capacity;
+        trim(state, capacity);
+    }
+
+
+    size_t XPathCache::get_capacity()
+    {
+        return get_state().capacity.load(std::memory_order_relaxed);
+    }
+
+
+    std::shared_ptr<const XPath> XPathCache::get(const std::string& expression)
+    {
+        CacheState& state = get_state();
+        {
+            std::lock_guard<std::mutex> lock(state.mutex);
+            std::unordered_map<std::string, std::list<CacheEntry>::iterator>::iterator i = state.index.find(expression);
+            if (i != state.index.end())
+            {
+                state.entries.splice(state.entries.begin(), state.entries, i->second);
+                state.statistics.hits++;
+                return i->second->second;
+            }
+            state.statistics.misses++;
+        }
+
+        // Compile outside the lock; should two threads race on the same
+        // expression, the second simply replaces the first.
+        std::shared_ptr<const XPath> xpath(new XPath(expression));
+
+        std::lock_guard<std::mutex> lock(state.mutex);
+        const size_t capacity = state.capacity;
+        if (capacity == 0)
+        {
+            return xpath;
+        }
+
+        std::unordered_map<std::string, std::list<CacheEntry>::iterator>::iterator i = state.index.find(expression);
+        if (i != state.index.end())
+        {
+            state.entries.erase(i->second);
+            state.index.erase(i);
+        }
+        state.entries.push_front(CacheEntry(expression, xpath));
+        state.index[expression] = state.entries.begin();
+        trim(state, capacity);
+
+        return xpath;
+    }
+
+
+    XPathCache::Statistics XPathCache::get_statistics()
+    {
+        CacheState& state = get_state();
+        std::lock_guard<std::mutex> lock(state.mutex);
+        return state.statistics;
+    }
+
+
+    void XPathCache::clear()
+    {
+        CacheState& state = get_state();
+        std::lock_guard<std::mutex> lock(state.mutex);
+        state.entries.clear();
+        state.index.clear();
+        state.statistics = Statistics();
+    }
+}
@@ -0,0 +1,97 @@
+//
+// Copyright (c) 2008-2020 Sean Farrell
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of
+// this software and associated documentation files (the "Software"), to deal in
+// the Software without restriction, including without limitation the rights to use,
+// copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the
+// Software, and to permit persons to whom the Software is furnished to do so,
+// subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+// INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+// PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+// HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+// OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+// SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+
+#pragma once
+
+#include <string>
+#include <memory>
+
+#include "defines.h"
+#include "XPath.h"
+
+namespace xml
+{
+    /**
+     * Cache of Compiled XPath Expressions
+     *
+     * When enabled, all queries that take their XPath as string look the
+     * expression up in this cache, so that frequently used expressions are
+     * only compiled once. The cache holds up to a given number of
+     * expressions and evicts the least recently used one when full.
+     *
+     * The cache is disabled by default, call set_capacity to enable it.
+     * It is shared by all threads and safe to use concurrently.
+     **/
+    class LIBXMLMM_EXPORT XPathCache
+    {
+    public:
+        /**
+         * Usage Statistics
+         **/
+        struct Statistics
+        {
+            /** The number of lookups that found a compiled expression. **/
+            size_t hits;
+            /** The number of lookups that had to compile the expression. **/
+            size_t misses;
+            /** The number of expressions evicted to make room. **/
+            size_t evictions;
+            /** The number of expressions currently cached. **/
+            size_t size;
+        };
+
+        /**
+         * Set the maximum number of cached expressions.
+         *
+         * Setting the capacity to 0 disables and empties the cache.
+         **/
+        static void set_capacity(size_t capacity);
+
+        /**
+         * Get the maximum number of cached expressions.
+         **/
+        static size_t get_capacity();
+
+        /**
+         * Get a compiled expression.
+         *
+         * The expression is compiled and added to the cache if it is not
+         * already cached.
+         *
+         * @exception InvalidXPath Throws InvalidXPath if the expression
+         * does not compile.
+         **/
+        static std::shared_ptr<const XPath> get(const std::string& expression);
+
+        /**
+         * Get the usage statistics.
+         **/
+        static Statistics get_statistics();
+
+        /**
+         * Remove all expressions and reset the statistics.
+         **/
+        static void clear();
+
+    private:
+        XPathCache();
+    };
+}
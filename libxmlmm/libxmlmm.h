@@ -29,6 +29,19 @@
 #include "CData.h"
 #include "Comment.h"
 #include "ProcessingInstruction.h"
+#include "ParseOptions.h"
+#include "Parser.h"
+#include "Reader.h"
+#include "SaxHandler.h"
+#include "XPath.h"
+#include "XPathCache.h"
+#include "Library.h"
+#include "BatchLoader.h"
+#include "NodeSetView.h"
+#include "NodeRange.h"
+#include "ElementRange.h"
+#include "AttributeRange.h"
+#include "TreeWalker.h"
 #include "utils.h"
 #include "LibXmlSentry.h"
 #include "exceptions.h"
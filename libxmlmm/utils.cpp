@@ -24,6 +24,13 @@
 #include <cassert>
 #include <iostream>
 #include <iterator>
+#include <climits>
+#include <atomic>
+#include <vector>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+#include <libxml/parser.h>
 #include <libxml/xmlerror.h>
 
 #include "Node.h"
@@ -33,6 +40,7 @@
 #include "CData.h"
 #include "ProcessingInstruction.h"
 #include "Attribute.h"
+#include "exceptions.h"
 
 namespace xml
 {
@@ -51,48 +59,119 @@ namespace xml
     }
 
 
+    static std::atomic<bool> lazy_wrapping(false);
+
+
     void wrap_node(xmlNode* const cobj)
+    {
+        if (lazy_wrapping.load(std::memory_order_relaxed))
+        {
+            return;
+        }
+        Node* const wrapper = create_wrapper(cobj);
+        if (wrapper != NULL)
+        {
+            cobj->_private = wrapper;
+        }
+    }
+
+
+    // The wrapper pointer is read and published atomically, so that
+    // threads wrapping the same node in lazy mode agree on one wrapper.
+    static void* load_wrapper(xmlNode* const cobj)
+    {
+#ifdef _MSC_VER
+        return _InterlockedCompareExchangePointer(&cobj->_private, NULL, NULL);
+#else
+        return __atomic_load_n(&cobj->_private, __ATOMIC_ACQUIRE);
+#endif
+    }
+
+    static void* publish_wrapper(xmlNode* const cobj, void* const wrapper)
+    {
+#ifdef _MSC_VER
+        void* const previous = _InterlockedCompareExchangePointer(&cobj->_private, wrapper, NULL);
+        return previous != NULL ? previous : wrapper;
+#else
+        void* expected = NULL;
+        if (__atomic_compare_exchange_n(&cobj->_private, &expected, wrapper, false, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE))
+        {
+            return wrapper;
+        }
+        return expected;
+#endif
+    }
+
+
+    Node* get_wrapper(xmlNode* const cobj)
+    {
+        void* wrapper = load_wrapper(cobj);
+        if (wrapper == NULL)
+        {
+            Node* const created = create_wrapper(cobj);
+            if (created == NULL)
+            {
+                return NULL;
+            }
+            // Another thread may have been faster, then use its wrapper.
+            wrapper = publish_wrapper(cobj, created);
+            if (wrapper != created)
+            {
+                delete created;
+            }
+        }
+        return reinterpret_cast<Node*>(wrapper);
+    }
+
+
+    void set_lazy_wrapping(bool value)
+    {
+        lazy_wrapping.store(value);
+    }
+
+
+    bool get_lazy_wrapping()
+    {
+        return lazy_wrapping.load();
+    }
+
+
+    Node* create_wrapper(xmlNode* const cobj)
     {
         switch (cobj->type)
         {
             case XML_ELEMENT_NODE:
             {
-                cobj->_private = new Element(cobj);
-                break;
+                return new Element(cobj);
             }
             case XML_TEXT_NODE:
             {
-                cobj->_private = new Text(cobj);
-                break;
+                return new Text(cobj);
             }
             case XML_COMMENT_NODE:
             {
-                cobj->_private = new Comment(cobj);
-                break;
+                return new Comment(cobj);
             }
             case XML_CDATA_SECTION_NODE:
             {
-                cobj->_private = new CData(cobj);
-                break;
+                return new CData(cobj);
             }
             case XML_PI_NODE:
             {
-                cobj->_private = new ProcessingInstruction(cobj);
-                break;
+                return new ProcessingInstruction(cobj);
             }
             case XML_ATTRIBUTE_NODE:
             {
-                cobj->_private = new Attribute(cobj);
-                break;
+                return new Attribute(cobj);
             }
             case XML_DOCUMENT_NODE:
             {
                 /* this node is not wrapped */
-                break;
+                return NULL;
             }
             default:
             {
-                break;
+                return NULL;
             }
         }
     }
@@ -127,6 +206,145 @@ namespace xml
     }
 
 
+    bool get_attribute_view(const xmlAttr* const attr, std::string_view& value)
+    {
+        // xmlHasProp also finds defaults declared in the DTD.
+        if (attr->type == XML_ATTRIBUTE_DECL)
+        {
+            const xmlChar* const def = reinterpret_cast<const xmlAttribute*>(attr)->defaultValue;
+            value = def != NULL ? std::string_view(reinterpret_cast<const char*>(def)) : std::string_view();
+            return true;
+        }
+
+        const xmlNode* const text = attr->children;
+        if (text == NULL)
+        {
+            value = std::string_view();
+            return true;
+        }
+        if (text->next == NULL && text->type == XML_TEXT_NODE)
+        {
+            value = text->content != NULL ? std::string_view(reinterpret_cast<const char*>(text->content)) : std::string_view();
+            return true;
+        }
+        return false;
+    }
+
+
+    std::string get_attribute_value(const xmlAttr* const attr)
+    {
+        std::string_view view;
+        if (get_attribute_view(attr, view))
+        {
+            return std::string(view);
+        }
+
+        xmlChar* const tmp = xmlNodeListGetString(attr->doc, attr->children, 1);
+        std::string value;
+        if (tmp != NULL)
+        {
+            value = reinterpret_cast<const char*>(tmp);
+            xmlFree(tmp);
+        }
+        return value;
+    }
+
+
+    xmlDoc* read_memory(const char* data, size_t size, const char* url, int options)
+    {
+        if (size <= static_cast<size_t>(INT_MAX))
+        {
+            return xmlReadMemory(data, static_cast<int>(size), url, NULL, options);
+        }
+
+        xmlParserCtxt* ctxt = xmlCreatePushParserCtxt(NULL, NULL, NULL, 0, url);
+        if (ctxt == NULL)
+        {
+            return NULL;
+        }
+        xmlCtxtUseOptions(ctxt, options);
+
+        int error = push_memory(ctxt, data, size);
+        return finish_push_parser(ctxt, error);
+    }
+
+
+    xmlDoc* read_stream(std::istream& is, const char* url, int options)
+    {
+        xmlParserCtxt* ctxt = xmlCreatePushParserCtxt(NULL, NULL, NULL, 0, url);
+        if (ctxt == NULL)
+        {
+            return NULL;
+        }
+        xmlCtxtUseOptions(ctxt, options);
+
+        int error = push_stream(ctxt, is);
+        if (is.bad())
+        {
+            xmlFreeDoc(ctxt->myDoc);
+            xmlFreeParserCtxt(ctxt);
+            throw Exception("xml::read_stream(): failed to read from stream");
+        }
+
+        return finish_push_parser(ctxt, error);
+    }
+
+
+    int push_memory(xmlParserCtxt* ctxt, const char* data, size_t size)
+    {
+        const size_t chunk_size = 64 * 1024 * 1024;
+        int error = 0;
+        while (size > 0 && error == 0)
+        {
+            const size_t length = size < chunk_size ? size : chunk_size;
+            error = xmlParseChunk(ctxt, data, static_cast<int>(length), 0);
+            data += length;
+            size -= length;
+        }
+
+        if (error == 0)
+        {
+            error = xmlParseChunk(ctxt, NULL, 0, 1);
+        }
+        return error;
+    }
+
+
+    int push_stream(xmlParserCtxt* ctxt, std::istream& is)
+    {
+        std::vector<char> buffer(256 * 1024);
+        int error = 0;
+        while (is && error == 0)
+        {
+            is.read(&buffer[0], buffer.size());
+            const std::streamsize length = is.gcount();
+            if (length > 0)
+            {
+                error = xmlParseChunk(ctxt, &buffer[0], static_cast<int>(length), 0);
+            }
+        }
+
+        if (error == 0 && !is.bad())
+        {
+            error = xmlParseChunk(ctxt, NULL, 0, 1);
+        }
+        return error;
+    }
+
+
+    xmlDoc* finish_push_parser(xmlParserCtxt* ctxt, int error)
+    {
+        xmlDoc* doc = ctxt->myDoc;
+        if (error != 0 || !ctxt->wellFormed)
+        {
+            xmlFreeDoc(doc);
+            doc = NULL;
+        }
+        xmlFreeParserCtxt(ctxt);
+        return doc;
+    }
+
+
     std::string read_until_eof(std::istream& is)
     {
         std::string result;
@@ -24,11 +24,19 @@
 
 #include <iosfwd>
 #include <string>
+#include <string_view>
 #include <sstream>
+#include <charconv>
+#include <type_traits>
 #include <libxml/tree.h>
+#include <libxml/parser.h>
+
+#include "defines.h"
 
 namespace xml
 {
+    class Node;
+
     /**
      * Get the last error as string from libxml.
      **/
@@ -37,10 +45,47 @@ namespace xml
     /**
      * Wrap a node.
      *
-     * @note This function is used as callback to libxml.
+     * @note This function is used as callback to libxml. In lazy wrapping
+     * mode it does nothing.
      **/
     void wrap_node(xmlNode* const node);
 
+    /**
+     * Create a new wrapper for a node.
+     *
+     * The wrapper is not stored in the node.
+     *
+     * @return The wrapper or NULL if the node type is not wrapped.
+     **/
+    Node* create_wrapper(xmlNode* const node);
+
+    /**
+     * Get the wrapper of a node, creating it on first access.
+     *
+     * @note This function may be called concurrently for the same node;
+     * all callers get the same wrapper.
+     **/
+    LIBXMLMM_EXPORT Node* get_wrapper(xmlNode* const node);
+
+    /**
+     * Enable or disable lazy wrapping.
+     *
+     * By default every node libxml creates is wrapped immediately. In lazy
+     * wrapping mode the wrapper is only created when the node is first
+     * accessed, which saves time and memory when most nodes of a document
+     * are never touched.
+     *
+     * @note In lazy wrapping mode const accessors may create wrappers.
+     * Wrappers are published atomically, so concurrent const queries on
+     * one document remain safe.
+     **/
+    LIBXMLMM_EXPORT void set_lazy_wrapping(bool value);
+
+    /**
+     * Check if lazy wrapping is enabled.
+     **/
+    LIBXMLMM_EXPORT bool get_lazy_wrapping();
+
     /**
      * Free the wrapper of a node.
      *
@@ -48,29 +93,255 @@ namespace xml
      **/
     void free_wrapper(xmlNode* node);
 
+    /**
+     * Get the value of an attribute as stored in the tree.
+     *
+     * @param attr The attribute, as returned by xmlHasProp.
+     * @param value Set to the value, pointing into the tree.
+     *
+     * @return false if the value is not stored as one string, such as
+     * when it contains entity references.
+     **/
+    LIBXMLMM_EXPORT bool get_attribute_view(const xmlAttr* attr, std::string_view& value);
+
+    /**
+     * Get the value of an attribute.
+     *
+     * @param attr The attribute, as returned by xmlHasProp.
+     **/
+    LIBXMLMM_EXPORT std::string get_attribute_value(const xmlAttr* attr);
+
+    /**
+     * Parse a document from memory.
+     *
+     * Inputs that do not fit into libxml's int sized buffer lengths are fed
+     * to the push parser in chunks.
+     *
+     * @return The parsed document or NULL on error.
+     **/
+    xmlDoc* read_memory(const char* data, size_t size, const char* url, int options);
+
+    /**
+     * Parse a document from a stream.
+     *
+     * The stream is read in large blocks that are fed to the push parser
+     * as they arrive, the text is never held in memory as a whole.
+     *
+     * @return The parsed document or NULL on error.
+     *
+     * @exception Exception Throws Exception if reading the stream fails.
+     **/
+    xmlDoc* read_stream(std::istream& is, const char* url, int options);
+
+    /**
+     * Feed a memory buffer of arbitrary size to a push parser and
+     * terminate the parse.
+     *
+     * @return 0 on success or the libxml error code.
+     **/
+    int push_memory(xmlParserCtxt* ctxt, const char* data, size_t size);
+
+    /**
+     * Feed a stream in blocks to a push parser and terminate the parse.
+     *
+     * @return 0 on success or the libxml error code.
+     *
+     * @note The parse is not terminated if the stream goes bad.
+     **/
+    int push_stream(xmlParserCtxt* ctxt, std::istream& is);
+
+    /**
+     * Take the document from a finished push parse and release the parser
+     * context.
+     *
+     * @return The parsed document or NULL if parsing failed.
+     **/
+    xmlDoc* finish_push_parser(xmlParserCtxt* ctxt, int error);
+
+    /**
+     * Null terminated copy of a string view.
+     *
+     * libxml expects null terminated strings, but the data of a
+     * std::string_view does not have to be. Short strings are copied to a
+     * buffer on the stack, so that passing a view to libxml does not
+     * allocate.
+     **/
+    class NulTerminated
+    {
+    public:
+        explicit NulTerminated(std::string_view str)
+        {
+            if (str.size() < sizeof(buffer))
+            {
+                str.copy(buffer, str.size());
+                buffer[str.size()] = 0;
+                ptr = buffer;
+            }
+            else
+            {
+                heap.assign(str.data(), str.size());
+                ptr = heap.c_str();
+            }
+        }
+
+        const char* c_str() const
+        {
+            return ptr;
+        }
+
+        const xmlChar* xml_str() const
+        {
+            return reinterpret_cast<const xmlChar*>(ptr);
+        }
+
+    private:
+        char        buffer[128];
+        std::string heap;
+        const char* ptr;
+
+        NulTerminated(const NulTerminated&);
+        NulTerminated& operator = (const NulTerminated&);
+    };
+
     /** Read from a stream until EOF. **/
     std::string read_until_eof(std::istream& is);
 
+    /**
+     * Check if a type is converted with std::to_chars and std::from_chars.
+     *
+     * These are all arithmetic types, except bool and the character types,
+     * which keep the formatting of the stream operators.
+     **/
+    template <typename T>
+    struct is_charconv_type : std::integral_constant<bool,
+        (std::is_integral<T>::value || std::is_floating_point<T>::value) &&
+        !std::is_same<T, bool>::value &&
+        !std::is_same<T, char>::value &&
+        !std::is_same<T, signed char>::value &&
+        !std::is_same<T, unsigned char>::value &&
+        !std::is_same<T, wchar_t>::value &&
+        !std::is_same<T, char16_t>::value &&
+        !std::is_same<T, char32_t>::value> {};
+
     /**
      * Convert arbitrary value to string.
+     *
+     * Numbers are formatted independent of the locale and floating point
+     * numbers use the shortest form that reads back to the exact same
+     * value. Other types are written with operator <<.
+     **/
+    template <typename T>
+    std::string to_string(const T& value)
+    {
+        if constexpr (std::is_convertible<T, std::string_view>::value)
+        {
+            return std::string(std::string_view(value));
+        }
+        else if constexpr (is_charconv_type<T>::value)
+        {
+            char buffer[64];
+            const std::to_chars_result result = std::to_chars(buffer, buffer + sizeof(buffer), value);
+            return std::string(buffer, result.ptr);
+        }
+        else
+        {
+            std::stringstream buff;
+            buff << value;
+            return buff.str();
+        }
+    }
+
+    /**
+     * Convert arbitrary value from string.
+     *
+     * Leading and trailing whitespace is skipped and numbers may start
+     * with a plus sign. Other types are read with operator >>.
+     *
+     * @param str The text to convert.
+     * @param value Set to the converted value.
+     *
+     * @return false if str is not a valid value or has trailing text.
      **/
     template <typename T>
-    std::string to_string(T value)
+    bool parse_value(std::string_view str, T& value)
     {
-        std::stringstream buff;
-        buff << value;
-        return buff.str();
+        const size_t start = str.find_first_not_of(" \t\r\n");
+        if (start == std::string_view::npos)
+        {
+            return false;
+        }
+        str.remove_prefix(start);
+        str.remove_suffix(str.size() - str.find_last_not_of(" \t\r\n") - 1);
+
+        if constexpr (is_charconv_type<T>::value)
+        {
+            if (str.size() > 1 && str[0] == '+' && str[1] != '-')
+            {
+                str.remove_prefix(1);
+            }
+            const char* const end = str.data() + str.size();
+            const std::from_chars_result result = std::from_chars(str.data(), end, value);
+            return result.ec == std::errc() && result.ptr == end;
+        }
+        else if constexpr (std::is_same<T, bool>::value)
+        {
+            if (str == "1" || str == "true")
+            {
+                value = true;
+                return true;
+            }
+            if (str == "0" || str == "false")
+            {
+                value = false;
+                return true;
+            }
+            return false;
+        }
+        else
+        {
+            std::stringstream buff{std::string(str)};
+            buff >> value;
+            return !buff.fail() && buff.eof();
+        }
     }
 
     /**
      * Convert arbitrary value from string.
+     *
+     * Like operator >>, leading whitespace is skipped and only the start
+     * of str is read, so "12px" gives 12. Use parse_value to reject
+     * trailing text.
+     *
+     * @return The converted value or a default constructed value if str
+     * does not start with a valid value.
      **/
     template <typename T>
     T from_string(const std::string& str)
     {
-        std::stringstream buff(str);
-        T value;
-        buff >> value;
+        T value = T();
+        if constexpr (is_charconv_type<T>::value)
+        {
+            std::string_view text(str);
+            const size_t start = text.find_first_not_of(" \t\r\n");
+            if (start == std::string_view::npos)
+            {
+                return value;
+            }
+            text.remove_prefix(start);
+            if (text.size() > 1 && text[0] == '+' && text[1] != '-')
+            {
+                text.remove_prefix(1);
+            }
+            if (std::from_chars(text.data(), text.data() + text.size(), value).ec != std::errc())
+            {
+                value = T();
+            }
+        }
+        else
+        {
+            std::stringstream buff(str);
+            buff >> value;
+        }
         return value;
     }
 }